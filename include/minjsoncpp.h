@@ -6,7 +6,11 @@
 #include <string_view>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <variant>
+#include <optional>
+#include <initializer_list>
+#include <iterator>
 #include <charconv>
 #include <limits>
 #include <memory>
@@ -16,12 +20,46 @@
 #include <functional>
 #include <ostream>
 #include <stdexcept>
+#include <mutex>
+#include <shared_mutex>
+#include <system_error>
+#include <filesystem>
 #include <utility>
 #include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cfloat> // for FLT_EVAL_METHOD
 #if defined(_LIBCPP_VERSION) && _LIBCPP_VERSION < 200100
-#include <cstring> // for memcpy()
 #include <cstdlib> // for strtod()
 #endif
+#if !defined(MINJSONCPP_DISABLE_SIMD)
+#if defined(__AVX2__)
+#define MINJSONCPP_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86_FP) && _M_IX86_FP >= 2
+#define MINJSONCPP_SIMD_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define MINJSONCPP_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h> // for _BitScanForward(), _BitScanReverse(), _umul128()
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#define MINJSONCPP_POSIX
+#include <cerrno>
+#include <unistd.h>
+#endif
+#if !defined(MINJSONCPP_DISABLE_MMAP) && defined(MINJSONCPP_POSIX)
+#define MINJSONCPP_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#include <fstream>
+#endif
 
 #if defined(__clang__)
 #pragma clang diagnostic push
@@ -55,18 +93,781 @@ namespace minjson {
     using RemoveCVRef = std::remove_cv_t<std::remove_reference_t<T>>;
     template<typename String, typename... T>
     inline constexpr bool AreTypesConvertibleToStringXorSizeT =
-      ((std::is_convertible_v<T, String> != std::is_convertible_v<T, size_t>) && ...);
+      (((std::is_convertible_v<T, String> || std::is_convertible_v<T, std::string_view>) !=
+        std::is_convertible_v<T, size_t>) && ...);
+    template<typename String, typename T>
+    using EnableIfComparableWithString =
+      std::enable_if_t<std::is_convertible_v<const T&, std::string_view> && !std::is_same_v<T, String>, int>;
+  }
+
+  // Bump allocator for values which are destroyed all at once: memory is carved from chunks growing geometrically,
+  // deallocation does nothing, all chunks are freed when the arena is released or destroyed;
+  // not thread safe, values allocated from the arena must not outlive it.
+  struct Arena final {
+    static constexpr size_t DefaultInitialChunkSize = 64 * 1024;
+
+    explicit Arena(size_t initialChunkSize = DefaultInitialChunkSize) noexcept :
+      m_nextChunkSize{ std::max(initialChunkSize, sizeof(Chunk)) } {}
+    Arena(Arena &&other) noexcept { swap(other); }
+    Arena &operator=(Arena &&other) noexcept {
+      Arena{ std::move(other) }.swap(*this);
+      return *this;
+    }
+    ~Arena() { release(); }
+
+    [[nodiscard]] void *allocate(size_t size, size_t alignment) {
+      const uintptr_t current = reinterpret_cast<uintptr_t>(m_current);
+      const uintptr_t aligned = (current + alignment - 1) & ~(alignment - 1);
+      if (aligned - current + size <= static_cast<size_t>(m_end - m_current)) {
+        m_current += aligned - current + size;
+        return reinterpret_cast<void*>(aligned);
+      }
+      return allocateChunk(size, alignment);
+    }
+
+    // frees all chunks, values allocated from the arena must not be used afterwards
+    void release() noexcept {
+      while (m_chunks) {
+        Chunk *chunk = m_chunks;
+        m_chunks = chunk->previous;
+        ::operator delete(chunk, chunk->size);
+      }
+      m_current = m_end = nullptr;
+    }
+
+    [[nodiscard]] size_t chunkCount() const noexcept {
+      size_t count = 0;
+      for (const Chunk *chunk = m_chunks; chunk; chunk = chunk->previous)
+        ++count;
+      return count;
+    }
+
+    void swap(Arena &other) noexcept {
+      using std::swap;
+      swap(m_chunks, other.m_chunks);
+      swap(m_current, other.m_current);
+      swap(m_end, other.m_end);
+      swap(m_nextChunkSize, other.m_nextChunkSize);
+    }
+
+  private:
+    struct alignas(std::max_align_t) Chunk {
+      Chunk *previous;
+      size_t size; // including this header
+    };
+    static constexpr size_t MaxChunkSize = 64 * 1024 * 1024;
+
+    void *allocateChunk(size_t size, size_t alignment) {
+      const size_t required = sizeof(Chunk) + size + (alignment > alignof(Chunk) ? alignment : 0);
+      const size_t chunkSize = std::max(m_nextChunkSize, required);
+      Chunk *chunk = static_cast<Chunk*>(::operator new(chunkSize));
+      *chunk = { m_chunks, chunkSize };
+      m_chunks = chunk;
+      m_current = reinterpret_cast<char*>(chunk + 1);
+      m_end = reinterpret_cast<char*>(chunk) + chunkSize;
+      m_nextChunkSize = std::min(m_nextChunkSize * 2, std::max(m_nextChunkSize, MaxChunkSize));
+      return allocate(size, alignment);
+    }
+
+    Chunk *m_chunks = nullptr;
+    char *m_current = nullptr;
+    char *m_end = nullptr;
+    size_t m_nextChunkSize = DefaultInitialChunkSize;
+  };
+
+  // Allocators which free memory all at once rather than on deallocation (e.g. minjson::ArenaAllocator)
+  // declare `using is_monotonic = std::true_type;`, values using such allocators are trivially destructible,
+  // so destroying them does not walk through nested values; such values must not hold any other resources.
+  template<typename Allocator, typename = void>
+  inline constexpr bool IsMonotonicAllocator = false;
+  template<typename Allocator>
+  inline constexpr bool IsMonotonicAllocator<Allocator, std::void_t<typename Allocator::is_monotonic>> =
+    Allocator::is_monotonic::value;
+
+  // allocates from minjson::Arena, copies of the allocator (including rebound ones) refer to the same arena
+  template<typename T>
+  struct ArenaAllocator {
+    using value_type = T;
+    using is_monotonic = std::true_type;
+
+    ArenaAllocator(Arena &arena) noexcept : m_arena{ &arena } {}
+    template<typename U>
+    ArenaAllocator(const ArenaAllocator<U> &other) noexcept : m_arena{ &other.arena() } {}
+
+    [[nodiscard]] T *allocate(size_t n) {
+      if (n > std::numeric_limits<size_t>::max() / sizeof(T))
+        throw std::bad_array_new_length{};
+      return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+    void deallocate(T*, size_t) noexcept {}
+
+    [[nodiscard]] Arena &arena() const noexcept { return *m_arena; }
+
+    template<typename U>
+    [[nodiscard]] friend bool operator==(const ArenaAllocator &a, const ArenaAllocator<U> &b) noexcept {
+      return &a.arena() == &b.arena();
+    }
+    template<typename U>
+    [[nodiscard]] friend bool operator!=(const ArenaAllocator &a, const ArenaAllocator<U> &b) noexcept {
+      return &a.arena() != &b.arena();
+    }
+
+  private:
+    Arena *m_arena;
+  };
+
+  // Thread safe dictionary of object keys shared by parsers (see ParsingOptions::keyDictionary), e.g. process-wide:
+  // each distinct key is stored once and never removed, so interned keys stay valid until the dictionary is destroyed
+  // and equal interned keys have the same address.
+  struct KeyDictionary final {
+    explicit KeyDictionary(size_t initialChunkSize = 4096) : m_arena{ initialChunkSize } {}
+    KeyDictionary(const KeyDictionary&) = delete;
+    KeyDictionary &operator=(const KeyDictionary&) = delete;
+
+    // returns characters of the key stored in the dictionary
+    [[nodiscard]] std::string_view intern(std::string_view key) {
+      {
+        std::shared_lock lock{ m_mutex };
+        if (auto i = m_keys.find(key); i != m_keys.end())
+          return *i;
+      }
+      std::unique_lock lock{ m_mutex };
+      if (auto i = m_keys.find(key); i != m_keys.end()) // may have been inserted by another thread in the meantime
+        return *i;
+      // at least one byte, so that characters of the empty key are not null and it is borrowed like other keys
+      char *chars = static_cast<char*>(m_arena.allocate(std::max(key.size(), size_t{ 1 }), 1));
+      std::copy(key.begin(), key.end(), chars);
+      return *m_keys.insert({ chars, key.size() }).first;
+    }
+
+    [[nodiscard]] size_t size() const {
+      std::shared_lock lock{ m_mutex };
+      return m_keys.size();
+    }
+
+  private:
+    mutable std::shared_mutex m_mutex;
+    Arena m_arena;
+    std::unordered_set<std::string_view> m_keys;
+  };
+
+  namespace detail {
+    // cache of keys interned by a single parser in front of shared minjson::KeyDictionary,
+    // so repeated keys (e.g. of objects in an array) are found without taking the lock of the dictionary
+    struct KeyCache final {
+      std::string_view intern(std::string_view key) {
+        std::string_view &cached = keys[std::hash<std::string_view>{}(key) % Size];
+        if (cached.data() == nullptr || cached != key)
+          cached = dictionary->intern(key);
+        return cached;
+      }
+
+      static constexpr size_t Size = 64;
+      KeyDictionary *dictionary;
+      std::string_view keys[Size] = {}; // characters of interned keys are never null
+    };
+  }
+
+  // String that either owns its characters or borrows characters owned by something else (e.g. parsed input),
+  // borrowed characters are copied before the string is modified.
+  template<typename Allocator>
+  struct BasicBorrowingString {
+    using Owned = std::basic_string<char, std::char_traits<char>, detail::ReboundAllocator<Allocator, char>>;
+    using allocator_type = typename Owned::allocator_type;
+
+    BasicBorrowingString() = default;
+    explicit BasicBorrowingString(const Allocator &a) noexcept : owned{ a } {}
+    BasicBorrowingString(std::string_view s, const Allocator &a = {}) : owned{ s, a } {}
+    BasicBorrowingString(const char *s, const Allocator &a = {}) : owned{ s, a } {}
+    BasicBorrowingString(const BasicBorrowingString &other, const Allocator &a) :
+      borrowedData{ other.borrowedData }, borrowedSize{ other.borrowedSize }, owned{ other.owned, a } {}
+    BasicBorrowingString(BasicBorrowingString &&other, const Allocator &a) :
+      borrowedData{ other.borrowedData }, borrowedSize{ other.borrowedSize }, owned{ std::move(other.owned), a } {}
+
+    void borrow(std::string_view s) noexcept {
+      owned.clear();
+      borrowedData = s.data();
+      borrowedSize = s.size();
+    }
+    [[nodiscard]] bool isBorrowed() const noexcept { return borrowedData != nullptr; }
+
+    [[nodiscard]] const char *data() const noexcept { return isBorrowed() ? borrowedData : owned.data(); }
+    [[nodiscard]] size_t size() const noexcept { return isBorrowed() ? borrowedSize : owned.size(); }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] const char *begin() const noexcept { return data(); }
+    [[nodiscard]] const char *end() const noexcept { return data() + size(); }
+    operator std::string_view() const noexcept { return { data(), size() }; }
+
+    BasicBorrowingString &append(const char *first, const char *last) {
+      materialize();
+      owned.append(first, last);
+      return *this;
+    }
+    BasicBorrowingString &operator+=(std::string_view s) {
+      materialize();
+      owned += s;
+      return *this;
+    }
+    void reserve(size_t capacity) {
+      materialize();
+      owned.reserve(capacity);
+    }
+
+    [[nodiscard]] friend bool operator==(const BasicBorrowingString &a, const BasicBorrowingString &b) noexcept {
+      return equal(a, b);
+    }
+    [[nodiscard]] friend bool operator!=(const BasicBorrowingString &a, const BasicBorrowingString &b) noexcept {
+      return !equal(a, b);
+    }
+    [[nodiscard]] friend bool operator<(const BasicBorrowingString &a, const BasicBorrowingString &b) noexcept {
+      return std::string_view{ a } < std::string_view{ b };
+    }
+    template<typename T, detail::EnableIfComparableWithString<BasicBorrowingString, T> = 0>
+    [[nodiscard]] friend bool operator==(const BasicBorrowingString &a, const T &b) noexcept {
+      return equal(a, b);
+    }
+    template<typename T, detail::EnableIfComparableWithString<BasicBorrowingString, T> = 0>
+    [[nodiscard]] friend bool operator==(const T &a, const BasicBorrowingString &b) noexcept {
+      return equal(a, b);
+    }
+    template<typename T, detail::EnableIfComparableWithString<BasicBorrowingString, T> = 0>
+    [[nodiscard]] friend bool operator!=(const BasicBorrowingString &a, const T &b) noexcept { return !(a == b); }
+    template<typename T, detail::EnableIfComparableWithString<BasicBorrowingString, T> = 0>
+    [[nodiscard]] friend bool operator!=(const T &a, const BasicBorrowingString &b) noexcept { return !(a == b); }
+
+  private:
+    // strings borrowing the same characters (e.g. keys interned in minjson::KeyDictionary) are equal without comparison
+    static bool equal(std::string_view a, std::string_view b) noexcept {
+      return a.size() == b.size() && (a.data() == b.data() || a == b);
+    }
+    void materialize() {
+      if (isBorrowed()) {
+        owned.assign(borrowedData, borrowedSize);
+        borrowedData = nullptr;
+        borrowedSize = 0;
+      }
+    }
+
+    const char *borrowedData = nullptr;
+    size_t borrowedSize = 0;
+    Owned owned;
+  };
+
+  // String storing short contents inline, i.e. without allocation: of `Size` bytes (not counting stateful allocator)
+  // all but the last two are available for inline characters (the last byte holds their count or marks contents
+  // on the heap, and there is the null terminator), e.g. 30 characters by default in the size of libstdc++ std::string;
+  // minjson::CompactStringValuePolicy sizes it to fill the space of values.
+  template<typename Allocator, size_t Size = 32>
+  struct BasicCompactString : private detail::ReboundAllocator<Allocator, char> { // empty allocators take no space
+    using allocator_type = detail::ReboundAllocator<Allocator, char>;
+    static constexpr size_t InlineCapacity = Size - 2;
+
+    BasicCompactString() noexcept(std::is_nothrow_default_constructible_v<allocator_type>) = default;
+    explicit BasicCompactString(const Allocator &a) noexcept : allocator_type{ a } {}
+    BasicCompactString(std::string_view s, const Allocator &a = {}) : allocator_type{ a } { append(s); }
+    BasicCompactString(const char *s, const Allocator &a = {}) : BasicCompactString{ std::string_view{ s }, a } {}
+    BasicCompactString(const BasicCompactString &other) :
+      allocator_type{ Traits::select_on_container_copy_construction(other.get_allocator()) } {
+      append(other);
+    }
+    BasicCompactString(const BasicCompactString &other, const Allocator &a) : allocator_type{ a } { append(other); }
+    BasicCompactString(BasicCompactString &&other) noexcept : allocator_type{ std::move(other.allocator()) } {
+      take(other);
+    }
+    BasicCompactString(BasicCompactString &&other, const Allocator &a) : allocator_type{ a } {
+      if (allocator() == other.allocator())
+        take(other);
+      else
+        append(other);
+    }
+    BasicCompactString &operator=(const BasicCompactString &other) {
+      if (this != &other) {
+        clear();
+        append(other);
+      }
+      return *this;
+    }
+    BasicCompactString &operator=(BasicCompactString &&other) noexcept(Traits::is_always_equal::value) {
+      if (this == &other)
+        return *this;
+      if (allocator() == other.allocator()) {
+        release();
+        take(other);
+      }
+      else {
+        clear();
+        append(other);
+      }
+      return *this;
+    }
+    BasicCompactString &operator=(std::string_view s) {
+      if (s.size() > capacity()) { // then `s` is not contained in this string
+        clear();
+        return append(s);
+      }
+      std::char_traits<char>::move(mutableData(), s.data(), s.size()); // `s` may be contained in this string
+      setSize(s.size());
+      return *this;
+    }
+    ~BasicCompactString() { release(); }
+
+    [[nodiscard]] bool isInline() const noexcept { return inlineSize() != HeapMarker; }
+
+    [[nodiscard]] const char *data() const noexcept { return isInline() ? m_chars : m_heap.data; }
+    [[nodiscard]] const char *c_str() const noexcept { return data(); }
+    [[nodiscard]] size_t size() const noexcept { return isInline() ? inlineSize() : m_heap.size; }
+    [[nodiscard]] size_t capacity() const noexcept { return isInline() ? InlineCapacity : m_heap.capacity; }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] const char *begin() const noexcept { return data(); }
+    [[nodiscard]] const char *end() const noexcept { return data() + size(); }
+    [[nodiscard]] char operator[](size_t i) const noexcept { return data()[i]; }
+    operator std::string_view() const noexcept { return { data(), size() }; }
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return allocator(); }
+
+    void clear() noexcept { setSize(0); }
+    void reserve(size_t capacity) {
+      if (capacity > this->capacity())
+        reallocate(capacity, {});
+    }
+    BasicCompactString &append(const char *first, const char *last) {
+      const std::string_view s{ first, static_cast<size_t>(last - first) };
+      const size_t oldSize = size();
+      if (s.size() > capacity() - oldSize) {
+        reallocate(std::max(oldSize + s.size(), 2 * capacity()), s);
+        return *this;
+      }
+      std::copy(s.begin(), s.end(), mutableData() + oldSize);
+      setSize(oldSize + s.size());
+      return *this;
+    }
+    BasicCompactString &append(std::string_view s) { return append(s.data(), s.data() + s.size()); }
+    BasicCompactString &operator+=(std::string_view s) { return append(s); }
+    BasicCompactString &operator+=(char c) { return append(&c, &c + 1); }
+    void push_back(char c) { append(&c, &c + 1); }
+
+    [[nodiscard]] friend bool operator==(const BasicCompactString &a, const BasicCompactString &b) noexcept {
+      return std::string_view{ a } == std::string_view{ b };
+    }
+    [[nodiscard]] friend bool operator!=(const BasicCompactString &a, const BasicCompactString &b) noexcept {
+      return std::string_view{ a } != std::string_view{ b };
+    }
+    [[nodiscard]] friend bool operator<(const BasicCompactString &a, const BasicCompactString &b) noexcept {
+      return std::string_view{ a } < std::string_view{ b };
+    }
+    template<typename T, detail::EnableIfComparableWithString<BasicCompactString, T> = 0>
+    [[nodiscard]] friend bool operator==(const BasicCompactString &a, const T &b) noexcept {
+      return std::string_view{ a } == std::string_view{ b };
+    }
+    template<typename T, detail::EnableIfComparableWithString<BasicCompactString, T> = 0>
+    [[nodiscard]] friend bool operator==(const T &a, const BasicCompactString &b) noexcept {
+      return std::string_view{ a } == std::string_view{ b };
+    }
+    template<typename T, detail::EnableIfComparableWithString<BasicCompactString, T> = 0>
+    [[nodiscard]] friend bool operator!=(const BasicCompactString &a, const T &b) noexcept { return !(a == b); }
+    template<typename T, detail::EnableIfComparableWithString<BasicCompactString, T> = 0>
+    [[nodiscard]] friend bool operator!=(const T &a, const BasicCompactString &b) noexcept { return !(a == b); }
+
+  private:
+    using Traits = std::allocator_traits<allocator_type>;
+    struct Heap {
+      char *data;
+      size_t size;
+      size_t capacity; // not counting the null terminator
+    };
+    // the last byte does not overlap heap representation
+    static_assert(Size > sizeof(Heap) && Size - 2 < 0xFF, "unsupported size of minjson::BasicCompactString");
+    static constexpr unsigned char HeapMarker = 0xFF;
+
+    unsigned char inlineSize() const noexcept { return static_cast<unsigned char>(m_chars[Size - 1]); }
+    void setInlineSize(unsigned char size) noexcept { m_chars[Size - 1] = static_cast<char>(size); }
+    allocator_type &allocator() noexcept { return *this; }
+    const allocator_type &allocator() const noexcept { return *this; }
+    char *mutableData() noexcept { return isInline() ? m_chars : m_heap.data; }
+    void setSize(size_t size) noexcept {
+      if (isInline())
+        setInlineSize(static_cast<unsigned char>(size));
+      else
+        m_heap.size = size;
+      mutableData()[size] = '\0';
+    }
+    // `appended` characters may be contained in this string
+    void reallocate(size_t capacity, std::string_view appended) {
+      char *chars = Traits::allocate(allocator(), capacity + 1);
+      const size_t size = this->size() + appended.size();
+      std::copy(appended.begin(), appended.end(), std::copy(data(), data() + this->size(), chars));
+      chars[size] = '\0';
+      release();
+      m_heap = { chars, size, capacity };
+      setInlineSize(HeapMarker);
+    }
+    void release() noexcept {
+      if (!isInline())
+        Traits::deallocate(allocator(), m_heap.data, m_heap.capacity + 1);
+    }
+    // takes contents over leaving `other` empty
+    void take(BasicCompactString &other) noexcept {
+      if (other.isInline())
+        std::copy(other.m_chars, other.m_chars + other.inlineSize() + 1, m_chars);
+      else
+        m_heap = other.m_heap;
+      setInlineSize(other.inlineSize());
+      other.m_chars[0] = '\0';
+      other.setInlineSize(0);
+    }
+
+    union {
+      char m_chars[Size] = {};
+      Heap m_heap;
+    };
+  };
+}
+
+namespace std {
+  template<typename A>
+  struct hash<minjson::BasicBorrowingString<A>> {
+    size_t operator()(const minjson::BasicBorrowingString<A> &s) const noexcept { return hash<string_view>{}(s); }
+  };
+  template<typename A, size_t Size>
+  struct hash<minjson::BasicCompactString<A, Size>> {
+    size_t operator()(const minjson::BasicCompactString<A, Size> &s) const noexcept { return hash<string_view>{}(s); }
+  };
+}
+
+namespace minjson {
+
+  // JSON object stored in a vector, members are either kept in insertion order and looked up linearly
+  // (via hash index for large objects), or sorted by keys and looked up with binary search;
+  // keys must not be modified via iterators
+  template<typename Key, typename Value, typename Allocator, bool isSorted>
+  struct BasicFlatObject {
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using allocator_type = detail::ReboundAllocator<Allocator, value_type>;
+    using Members = std::vector<value_type, allocator_type>;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = typename Members::iterator;
+    using const_iterator = typename Members::const_iterator;
+
+    BasicFlatObject() = default;
+    explicit BasicFlatObject(const Allocator &a) : members{ a }, index{ a } {}
+    BasicFlatObject(std::initializer_list<value_type> init, const Allocator &a = {}) : members{ a }, index{ a } {
+      for (const auto &[key, value] : init)
+        tryAppend(key, value);
+      sortMembers();
+    }
+    BasicFlatObject(const BasicFlatObject &other, const Allocator &a) :
+      members{ other.members, a }, index{ other.index, a } {}
+    BasicFlatObject(BasicFlatObject &&other, const Allocator &a) :
+      members{ std::move(other.members), a }, index{ std::move(other.index), a } {}
+
+    [[nodiscard]] iterator begin() noexcept { return members.begin(); }
+    [[nodiscard]] const_iterator begin() const noexcept { return members.begin(); }
+    [[nodiscard]] iterator end() noexcept { return members.end(); }
+    [[nodiscard]] const_iterator end() const noexcept { return members.end(); }
+    [[nodiscard]] size_t size() const noexcept { return members.size(); }
+    [[nodiscard]] bool empty() const noexcept { return members.empty(); }
+    void reserve(size_t capacity) { members.reserve(capacity); }
+    void clear() noexcept {
+      members.clear();
+      index.clear();
+    }
+
+    [[nodiscard]] iterator find(std::string_view key) { return begin() + (std::as_const(*this).find(key) - begin()); }
+    [[nodiscard]] const_iterator find(std::string_view key) const {
+      if constexpr (isSorted) {
+        const auto i = lowerBound(key);
+        return i != end() && std::string_view{ i->first } == key ? i : end();
+      }
+      else {
+        return findUnsorted(key);
+      }
+    }
+    // same as find(key) with precomputed `std::hash<std::string_view>{}(key)`
+    [[nodiscard]] iterator find(std::string_view key, size_t keyHash) {
+      return begin() + (std::as_const(*this).find(key, keyHash) - begin());
+    }
+    [[nodiscard]] const_iterator find(std::string_view key, size_t keyHash) const {
+      if constexpr (!isSorted) {
+        if (!index.empty())
+          return findIndexed(key, keyHash);
+      }
+      return find(key);
+    }
+    [[nodiscard]] size_t count(std::string_view key) const { return find(key) != end() ? 1 : 0; }
+    [[nodiscard]] bool contains(std::string_view key) const { return find(key) != end(); }
+    [[nodiscard]] Value &at(std::string_view key) { return const_cast<Value&>(std::as_const(*this).at(key)); }
+    [[nodiscard]] const Value &at(std::string_view key) const {
+      const auto i = find(key);
+      if (i == end())
+        throw std::out_of_range{ "JSON object does not contain the key" };
+      return i->second;
+    }
+    Value &operator[](const Key &key) { return try_emplace(key).first->second; }
+    Value &operator[](Key &&key) { return try_emplace(std::move(key)).first->second; }
+
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key &key, Args&&... args) {
+      return tryEmplace(key, std::forward<Args>(args)...);
+    }
+    template<typename... Args>
+    std::pair<iterator, bool> try_emplace(Key &&key, Args&&... args) {
+      return tryEmplace(std::move(key), std::forward<Args>(args)...);
+    }
+    std::pair<iterator, bool> insert(const value_type &member) { return tryEmplace(member.first, member.second); }
+    std::pair<iterator, bool> insert(value_type &&member) {
+      return tryEmplace(std::move(member.first), std::move(member.second));
+    }
+
+    // for building objects in linear time (e.g. while parsing) members of sorted objects are appended unsorted
+    // (duplicate keys are still detected), then sorted at once by sortMembers(), in the meantime the object must
+    // not be used otherwise; for unsorted objects these are the same as try_emplace() and no-op respectively
+    template<typename... Args>
+    std::pair<iterator, bool> tryEmplaceUnsorted(Key &&key, Args&&... args) {
+      return tryAppend(std::move(key), std::forward<Args>(args)...);
+    }
+    void sortMembers() {
+      if constexpr (isSorted) {
+        // keys are unique, so there is nothing to deduplicate
+        std::sort(members.begin(), members.end(), [](const value_type &a, const value_type &b) {
+          return std::string_view{ a.first } < std::string_view{ b.first };
+        });
+        decltype(index){ index.get_allocator() }.swap(index);
+      }
+    }
+
+    iterator erase(const_iterator position) {
+      const auto i = members.erase(position);
+      if (!index.empty())
+        rebuildIndex();
+      return i;
+    }
+    size_t erase(std::string_view key) {
+      const auto i = find(key);
+      if (i == end())
+        return 0;
+      erase(i);
+      return 1;
+    }
+
+    [[nodiscard]] friend bool operator==(const BasicFlatObject &a, const BasicFlatObject &b) {
+      if constexpr (isSorted) {
+        return a.members == b.members;
+      }
+      else {
+        return a.size() == b.size() && std::all_of(a.begin(), a.end(), [&b](const value_type &m) {
+          const auto i = b.find(m.first);
+          return i != b.end() && i->second == m.second;
+                                                   });
+      }
+    }
+    [[nodiscard]] friend bool operator!=(const BasicFlatObject &a, const BasicFlatObject &b) { return !(a == b); }
+
+  private:
+    static constexpr size_t MaxLinearlySearchedMembers = 16;
+
+    static size_t hash(std::string_view key) noexcept { return std::hash<std::string_view>{}(key); }
+    const_iterator findIndexed(std::string_view key, size_t keyHash) const {
+      const size_t mask = index.size() - 1;
+      for (size_t h = keyHash & mask;; h = (h + 1) & mask) {
+        if (!index[h])
+          return end();
+        if (const auto i = begin() + (index[h] - 1); std::string_view{ i->first } == key)
+          return i;
+      }
+    }
+    const_iterator findUnsorted(std::string_view key) const {
+      if (index.empty())
+        return std::find_if(begin(), end(), [key](const value_type &m) { return std::string_view{ m.first } == key; });
+      return findIndexed(key, hash(key));
+    }
+    const_iterator lowerBound(std::string_view key) const {
+      return std::lower_bound(begin(), end(), key,
+                              [](const value_type &m, std::string_view key) { return std::string_view{ m.first } < key; });
+    }
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> tryEmplace(K &&key, Args&&... args) {
+      if constexpr (isSorted) {
+        const auto i = lowerBound(key);
+        if (i != end() && std::string_view{ i->first } == std::string_view{ key })
+          return { begin() + (i - begin()), false };
+        return { members.emplace(i, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                                 std::forward_as_tuple(std::forward<Args>(args)...)), true };
+      }
+      else {
+        return tryAppend(std::forward<K>(key), std::forward<Args>(args)...);
+      }
+    }
+    template<typename K, typename... Args>
+    std::pair<iterator, bool> tryAppend(K &&key, Args&&... args) {
+      if (const auto i = findUnsorted(key); i != end())
+        return { begin() + (i - begin()), false };
+      members.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+      if (members.size() > MaxLinearlySearchedMembers) {
+        if (members.size() * 2 > index.size())
+          rebuildIndex();
+        else
+          addToIndex(members.size() - 1);
+      }
+      return { end() - 1, true };
+    }
+    void rebuildIndex() {
+      if (members.size() <= MaxLinearlySearchedMembers) {
+        index.clear();
+        return;
+      }
+      size_t capacity = 4 * MaxLinearlySearchedMembers;
+      while (capacity < members.size() * 2)
+        capacity *= 2;
+      index.assign(capacity, 0);
+      for (size_t i = 0; i < members.size(); ++i)
+        addToIndex(i);
+    }
+    void addToIndex(size_t position) {
+      const size_t mask = index.size() - 1;
+      size_t h = hash(members[position].first) & mask;
+      while (index[h])
+        h = (h + 1) & mask;
+      index[h] = static_cast<uint32_t>(position + 1);
+    }
+
+    Members members;
+    std::vector<uint32_t, detail::ReboundAllocator<Allocator, uint32_t>> index; // open addressing, positions + 1
+  };
+  template<typename Key, typename Value, typename Allocator>
+  using FlatObject = BasicFlatObject<Key, Value, Allocator, false>;
+  template<typename Key, typename Value, typename Allocator>
+  using SortedFlatObject = BasicFlatObject<Key, Value, Allocator, true>;
+
+  // hashes anything convertible to std::string_view, transparent to allow heterogeneous lookup where supported
+  struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view s) const noexcept { return std::hash<std::string_view>{}(s); }
+  };
+
+  // Policies define types of JSON values stored in minjson::BasicValue.
+  struct DefaultValuePolicy {
+    template<typename Allocator>
+    using String = std::basic_string<char, std::char_traits<char>, detail::ReboundAllocator<Allocator, char>>;
+    template<typename Key, typename Value, typename Allocator>
+    using Object = std::unordered_map<Key, Value, StringHash, std::equal_to<>,
+      detail::ReboundAllocator<Allocator, std::pair<const Key, Value>>>;
+  };
+  // Strings without escapes borrow characters from the parsed input which must outlive parsed values.
+  struct ZeroCopyValuePolicy : DefaultValuePolicy {
+    template<typename Allocator>
+    using String = BasicBorrowingString<Allocator>;
+  };
+  struct FlatObjectValuePolicy : DefaultValuePolicy {
+    template<typename Key, typename Value, typename Allocator>
+    using Object = FlatObject<Key, Value, Allocator>;
+  };
+  struct SortedFlatObjectValuePolicy : DefaultValuePolicy {
+    template<typename Key, typename Value, typename Allocator>
+    using Object = SortedFlatObject<Key, Value, Allocator>;
+  };
+  namespace detail {
+    // size of minjson::BasicCompactString taking as much space in minjson::BasicValue as the largest other alternative
+    // (the default object, e.g. 54 inline characters in libstdc++) so values do not grow
+    template<typename Allocator>
+    inline constexpr size_t CompactStringSize = std::max({
+      size_t{ 32 },
+      sizeof(DefaultValuePolicy::Object<std::string_view, std::string_view, Allocator>),
+      sizeof(std::vector<std::string_view, ReboundAllocator<Allocator, std::string_view>>)
+    }) - (std::is_empty_v<ReboundAllocator<Allocator, char>> ? 0 : sizeof(ReboundAllocator<Allocator, char>));
+  }
+  // Strings (including object keys) are stored inline in the space of the value, see minjson::BasicCompactString.
+  struct CompactStringValuePolicy : DefaultValuePolicy {
+    template<typename Allocator>
+    using String = BasicCompactString<Allocator, detail::CompactStringSize<Allocator>>;
+  };
+  // Keys of objects may borrow characters, parsed keys borrow them from minjson::KeyDictionary if one is provided
+  // (see ParsingOptions::keyDictionary) which must outlive parsed values; strings are owned as usual.
+  struct InternedKeysValuePolicy : DefaultValuePolicy {
+    template<typename Key, typename Value, typename Allocator>
+    using Object = DefaultValuePolicy::Object<BasicBorrowingString<Allocator>, Value, Allocator>;
+  };
+
+  namespace detail {
+    template<typename Object>
+    inline constexpr bool IsFlatObject = false;
+    template<typename Key, typename Value, typename Allocator, bool isSorted>
+    inline constexpr bool IsFlatObject<BasicFlatObject<Key, Value, Allocator, isSorted>> = true;
+    template<typename Object, typename = void>
+    inline constexpr bool HasHeterogeneousLookup = IsFlatObject<Object>;
+
+    // adds member to object being built, members of sorted flat objects are sorted by sortMembers() at once
+    template<typename Object>
+    auto tryEmplaceMember(Object &object, typename Object::key_type &&key) {
+      if constexpr (IsFlatObject<Object>)
+        return object.tryEmplaceUnsorted(std::move(key));
+      else
+        return object.try_emplace(std::move(key));
+    }
+    template<typename Object>
+    void sortMembers([[maybe_unused]] Object &object) {
+      if constexpr (IsFlatObject<Object>)
+        object.sortMembers();
+    }
+#if defined(__cpp_lib_generic_unordered_lookup)
+    template<typename Object>
+    inline constexpr bool HasHeterogeneousLookup<Object,
+      std::void_t<typename Object::hasher::is_transparent, typename Object::key_equal::is_transparent>> = true;
+#endif
+    template<typename String, typename = void>
+    inline constexpr bool CanBorrowCharacters = false;
+    template<typename String>
+    inline constexpr bool CanBorrowCharacters<String,
+      std::void_t<decltype(std::declval<String&>().borrow(std::string_view{}))>> = true;
+
+    // looks up object member without allocating a key where possible
+    template<typename Object>
+    auto findMember(const Object &object, std::string_view key) {
+      if constexpr (HasHeterogeneousLookup<Object>) {
+        return object.find(key);
+      }
+      else {
+        using Key = typename Object::key_type;
+        using KeyAllocator = typename Key::allocator_type;
+        if constexpr (CanBorrowCharacters<Key>) {
+          Key k{ KeyAllocator{ object.get_allocator() } }; // allocators may be not default constructible
+          k.borrow(key);
+          return object.find(k);
+        }
+        else if constexpr (std::is_same_v<KeyAllocator, ArenaAllocator<char>>) {
+          // memory of the object's arena is never reused, so the temporary key is allocated from a scratch arena
+          Arena scratch{ key.size() + 1 };
+          const Key k{ key, KeyAllocator{ scratch } };
+          return object.find(k);
+        }
+        else {
+          const Key k{ key, KeyAllocator{ object.get_allocator() } };
+          return object.find(k);
+        }
+      }
+    }
+    // `keyHash` must be `std::hash<std::string_view>{}(key)`
+    template<typename Object>
+    auto findMember(const Object &object, std::string_view key, [[maybe_unused]] size_t keyHash) {
+      if constexpr (IsFlatObject<Object>)
+        return object.find(key, keyHash);
+      else
+        return findMember(object, key);
+    }
   }
 
   template<typename Allocator>
+  struct BasicJsonPointer;
+
+  template<typename Allocator, typename Policy = DefaultValuePolicy>
   struct BasicValue {
     using Null = std::monostate;
     using Boolean = bool;
-    using String = std::basic_string<char, std::char_traits<char>, detail::ReboundAllocator<Allocator, char>>;
+    using String = typename Policy::template String<Allocator>;
     using Array = std::vector<BasicValue, detail::ReboundAllocator<Allocator, BasicValue>>;
-    using Object = std::unordered_map<String, BasicValue,
-      std::hash<String>, std::equal_to<String>,
-      detail::ReboundAllocator<Allocator, std::pair<const String, BasicValue>>>;
+    using Object = typename Policy::template Object<String, BasicValue, Allocator>;
     using Variant = std::variant<Null, Boolean, int64_t, double, String, Array, Object>;
 
     BasicValue() = default;
@@ -148,6 +949,12 @@ namespace minjson {
       BasicValue*> resolve(T&&... refTokens) noexcept {
       return const_cast<BasicValue*>(std::as_const(*this).resolve(std::forward<T>(refTokens)...));
     }
+    template<typename A>
+    [[nodiscard]] const BasicValue *resolve(const BasicJsonPointer<A> &pointer) const noexcept {
+      return pointer.resolve(*this);
+    }
+    template<typename A>
+    [[nodiscard]] BasicValue *resolve(const BasicJsonPointer<A> &pointer) noexcept { return pointer.resolve(*this); }
 
   private:
     template<typename T>
@@ -175,34 +982,34 @@ namespace minjson {
         return &(*array)[index];
       return nullptr;
     }
-    const BasicValue *resolveImpl(const String &key) const noexcept {
+    template<typename T, std::enable_if_t<!std::is_convertible_v<T&&, size_t>, int> = 0>
+    const BasicValue *resolveImpl(T &&key) const noexcept {
+      if constexpr (std::is_convertible_v<T&&, std::string_view>)
+        return resolveKey(key);
+      else
+        return resolveKey(String{ std::forward<T>(key) });
+    }
+    const BasicValue *resolveKey(std::string_view key) const noexcept {
       if (auto *object = std::get_if<Object>(&variant())) {
-        if (auto i = object->find(key); i != object->end())
+        if (auto i = detail::findMember(*object, key); i != object->end())
           return &i->second;
       }
       return nullptr;
     }
 
-#if !defined(_GLIBCXX_RELEASE) || _GLIBCXX_RELEASE >= 12
-    Variant m_data;
-#else // std::unordered_map does not support incomplete types in libstdc++ version < 12
-    struct Workaround final {
-      Workaround() noexcept { ::new(&storage) Variant{}; }
-      Workaround(const Workaround &other) { ::new(&storage) Variant{ other.operator const Variant & () }; }
-      Workaround(Workaround &&other) noexcept(std::is_nothrow_move_constructible_v<Variant>) {
+    // variant in raw storage which is trivially destructible, i.e. the variant is not destroyed
+    struct Storage {
+      Storage() noexcept { ::new(&storage) Variant{}; }
+      Storage(const Storage &other) { ::new(&storage) Variant{ other.operator const Variant & () }; }
+      Storage(Storage &&other) noexcept(std::is_nothrow_move_constructible_v<Variant>) {
         ::new(&storage) Variant{ std::move(other.operator Variant & ()) };
       }
       template<typename... T>
-      Workaround(T&&... v) noexcept(std::is_nothrow_constructible_v<Variant, T&&...>) {
+      Storage(T&&... v) noexcept(std::is_nothrow_constructible_v<Variant, T&&...>) {
         ::new(&storage) Variant{ std::forward<T>(v)... };
       }
-      ~Workaround() {
-        static_assert(sizeof(DummyVariant) == sizeof(Variant));
-        static_assert(alignof(DummyVariant) == alignof(Variant));
-        operator Variant&().~Variant();
-      }
-      auto &operator=(const Workaround &other) { return operator Variant & () = other.operator const Variant & (); }
-      auto &operator=(Workaround &&other) noexcept(std::is_nothrow_move_assignable_v<Variant>) {
+      auto &operator=(const Storage &other) { return operator Variant & () = other.operator const Variant & (); }
+      auto &operator=(Storage &&other) noexcept(std::is_nothrow_move_assignable_v<Variant>) {
         return operator Variant & () = std::move(other.operator Variant & ());
       }
       operator const Variant&() const& noexcept { return *std::launder(reinterpret_cast<const Variant*>(&storage)); }
@@ -210,20 +1017,46 @@ namespace minjson {
       operator Variant && () && noexcept { return std::move(operator Variant & ()); }
       operator const Variant && () const&& noexcept { return std::move(operator const Variant & ()); }
 
-    private:
-      using DummyUnorderedMap = std::unordered_map<String, Array,
-        std::hash<String>, std::equal_to<String>,
-        detail::ReboundAllocator<Allocator, std::pair<const String, Array>>>;
-      using DummyVariant = std::variant<Null, Boolean, int64_t, double, String, Array, DummyUnorderedMap>;
-      alignas(DummyVariant) uint8_t storage[sizeof(DummyVariant)];
-    } m_data;
+    protected:
+#if !defined(_GLIBCXX_RELEASE) || _GLIBCXX_RELEASE >= 12
+      using StoredVariant = Variant;
+#else // std::unordered_map does not support incomplete types in libstdc++ version < 12
+      using DummyObject = typename Policy::template Object<String, Array, Allocator>;
+      using StoredVariant = std::variant<Null, Boolean, int64_t, double, String, Array, DummyObject>;
+#endif
+      alignas(StoredVariant) uint8_t storage[sizeof(StoredVariant)];
+    };
+#if !defined(_GLIBCXX_RELEASE) || _GLIBCXX_RELEASE >= 12
+    using DestroyingStorage = Variant;
+#else
+    struct DestroyingStorage final : Storage {
+      using Storage::Storage;
+      DestroyingStorage() = default;
+      DestroyingStorage(const DestroyingStorage&) = default;
+      DestroyingStorage(DestroyingStorage&&) = default;
+      DestroyingStorage &operator=(const DestroyingStorage&) = default;
+      DestroyingStorage &operator=(DestroyingStorage&&) = default;
+      ~DestroyingStorage() {
+        static_assert(sizeof(typename Storage::StoredVariant) == sizeof(Variant));
+        static_assert(alignof(typename Storage::StoredVariant) == alignof(Variant));
+        this->operator Variant&().~Variant();
+      }
+    };
 #endif
+    // memory of monotonic allocators is freed all at once, so nested values need not be destroyed one by one
+    std::conditional_t<IsMonotonicAllocator<Allocator>, Storage, DestroyingStorage> m_data;
   };
 #if defined(_GLIBCXX_RELEASE) && _GLIBCXX_RELEASE < 12 && defined(__clang__) && __clang_major__ < 21
   static_assert(std::is_copy_constructible_v<BasicValue<std::allocator<char>>>); // for some reason clang needs this
 #endif
 
   using Value = BasicValue<std::allocator<char>>;
+  using ZeroCopyValue = BasicValue<std::allocator<char>, ZeroCopyValuePolicy>;
+  using FlatObjectValue = BasicValue<std::allocator<char>, FlatObjectValuePolicy>;
+  using SortedFlatObjectValue = BasicValue<std::allocator<char>, SortedFlatObjectValuePolicy>;
+  using InternedKeysValue = BasicValue<std::allocator<char>, InternedKeysValuePolicy>;
+  using CompactStringValue = BasicValue<std::allocator<char>, CompactStringValuePolicy>;
+  using ArenaValue = BasicValue<ArenaAllocator<char>>;
   using Object = Value::Object;
   using Array = Value::Array;
   using String = Value::String;
@@ -233,8 +1066,8 @@ namespace minjson {
 
   namespace detail {
     void GetValue(...); // intentionally not implemented
-    template<typename Allocator>
-    BasicValue<Allocator> GetValue(const BasicValue<Allocator>&); // intentionally not implemented
+    template<typename Allocator, typename Policy>
+    BasicValue<Allocator, Policy> GetValue(const BasicValue<Allocator, Policy>&); // intentionally not implemented
     template<typename T>
     using RawBaseValueType = decltype(GetValue(std::declval<RemoveCVRef<T>>()));
   }
@@ -245,41 +1078,716 @@ namespace minjson {
     return std::visit(std::forward<F>(f), std::forward<T>(value).detail::template RawBaseValueType<T>::variant());
   }
 
-
-  enum class Escape {
-    Default,
-    NonAscii
-  };
-  enum class Utf8Validation {
-    IgnoreInvalidUtf8CodeUnits, // a.k.a. "garbage in - garbage out"
-    FailOnInvalidUtf8CodeUnits  // operation fails on first invalid UTF-8 code point/code unit
-  };
-  enum class HexDigitsCase {
-    Lower,
-    Upper
-  };
-
   namespace detail {
-    inline char matchCommonCharacterToEscape(char c) {
-      switch (c) {
-      case '\b': return 'b';
-      case '\t': return 't';
-      case '\n': return 'n';
-      case '\f': return 'f';
-      case '\r': return 'r';
-      case '\"': return '\"';
-      case '\\': return '\\';
-      }
-      return '\0';
+    // tape is a sequence of 64-bit words, first word of a value contains a tag in the upper byte and
+    // - null, true, false: nothing else;
+    // - integer, decimal: is followed by a word containing the value;
+    // - string: offset of characters in the string buffer, is followed by a word containing the size;
+    // - array, object: number of words taken by the value, is followed by a word containing the number of members;
+    //   members of objects are keys (strings) followed by values
+    enum class TapeTag : uint8_t {
+      Null = 'n',
+      True = 't',
+      False = 'f',
+      Integer = 'l',
+      Decimal = 'd',
+      String = '\"',
+      Array = '[',
+      Object = '{'
+    };
+    constexpr uint64_t makeTapeWord(TapeTag tag, uint64_t payload = 0) {
+      return uint64_t{ static_cast<uint8_t>(tag) } << 56 | payload;
     }
-    inline bool isControlCharacter(char c) { return (c & '\xe0') == 0; }
-    template<size_t N>
-    bool isUtf8CodeUnit(char c) {
-      constexpr uint8_t mask = static_cast<uint8_t>(0xffu << (7 - N));
-      constexpr uint8_t pattern = static_cast<uint8_t>(0xffu << (8 - N));
-      return (mask & static_cast<uint8_t>(c)) == pattern;
+    constexpr TapeTag getTapeTag(uint64_t word) { return static_cast<TapeTag>(word >> 56); }
+    constexpr uint64_t getTapePayload(uint64_t word) { return word & 0x00ffffffffffffffu; }
+    inline constexpr uint64_t NullTapeWord = makeTapeWord(TapeTag::Null);
+
+    inline const uint64_t *skipTapeValue(const uint64_t *p) {
+      switch (getTapeTag(*p)) {
+      case TapeTag::Null:
+      case TapeTag::True:
+      case TapeTag::False:
+        return p + 1;
+      case TapeTag::Integer:
+      case TapeTag::Decimal:
+      case TapeTag::String:
+        return p + 2;
+      default:
+        return p + getTapePayload(*p);
+      }
     }
-    inline size_t getExpectedUtf8CodePointSize(char c) {
+
+    template<typename Allocator>
+    struct TapeBuilder;
+  }
+
+  // read-only reference to a value stored in minjson::BasicDocument
+  struct DocumentElement final {
+    using Null = std::monostate;
+    using Boolean = bool;
+    using String = std::string_view;
+    struct Array;
+    struct Object;
+
+    DocumentElement() noexcept = default; // refers to null value
+
+    [[nodiscard]] bool isObject() const noexcept { return tag() == detail::TapeTag::Object; }
+    [[nodiscard]] Object asObject() const;
+
+    [[nodiscard]] bool isArray() const noexcept { return tag() == detail::TapeTag::Array; }
+    [[nodiscard]] Array asArray() const;
+
+    [[nodiscard]] bool isString() const noexcept { return tag() == detail::TapeTag::String; }
+    [[nodiscard]] String asString() const {
+      check(isString());
+      return { strings + detail::getTapePayload(*word), static_cast<size_t>(word[1]) };
+    }
+
+    [[nodiscard]] bool isDouble() const noexcept { return tag() == detail::TapeTag::Decimal; }
+    [[nodiscard]] double asDouble() const {
+      check(isDouble());
+      double d;
+      std::memcpy(&d, word + 1, sizeof(d));
+      return d;
+    }
+
+    [[nodiscard]] bool isInt() const noexcept { return tag() == detail::TapeTag::Integer; }
+    [[nodiscard]] int64_t asInt() const {
+      check(isInt());
+      return static_cast<int64_t>(word[1]);
+    }
+
+    [[nodiscard]] bool isBool() const noexcept { return tag() == detail::TapeTag::True || tag() == detail::TapeTag::False; }
+    [[nodiscard]] Boolean asBool() const {
+      check(isBool());
+      return tag() == detail::TapeTag::True;
+    }
+
+    [[nodiscard]] bool isNull() const noexcept { return tag() == detail::TapeTag::Null; }
+
+    template<typename... T>
+    [[nodiscard]] std::enable_if_t<sizeof...(T) >= 1 && detail::AreTypesConvertibleToStringXorSizeT<String, T&&...>,
+      std::optional<DocumentElement>> resolve(T&&... refTokens) const {
+      std::optional<DocumentElement> element = *this;
+      (void)(static_cast<bool>(element = element->resolveImpl(std::forward<T>(refTokens))) && ...);
+      return element;
+    }
+    template<typename Allocator>
+    [[nodiscard]] std::optional<DocumentElement> resolve(const BasicJsonPointer<Allocator> &pointer) const {
+      return pointer.resolve(*this);
+    }
+
+  private:
+    template<typename Allocator>
+    friend struct BasicDocument;
+    template<typename F>
+    friend decltype(auto) visit(F &&f, const DocumentElement &e);
+
+    DocumentElement(const uint64_t *word, const char *strings) noexcept : word{ word }, strings{ strings } {}
+
+    detail::TapeTag tag() const noexcept { return detail::getTapeTag(*word); }
+    static void check(bool isExpectedType) {
+      if (!isExpectedType)
+        throw std::bad_variant_access{};
+    }
+    std::optional<DocumentElement> resolveImpl(size_t index) const;
+    std::optional<DocumentElement> resolveImpl(String key) const;
+
+    const uint64_t *word = &detail::NullTapeWord;
+    const char *strings = nullptr;
+  };
+
+  struct DocumentElement::Array final {
+    struct Iterator {
+      using iterator_category = std::input_iterator_tag;
+      using value_type = DocumentElement;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = DocumentElement;
+
+      DocumentElement operator*() const noexcept { return { word, strings }; }
+      Iterator &operator++() noexcept {
+        word = detail::skipTapeValue(word);
+        return *this;
+      }
+      Iterator operator++(int) noexcept {
+        Iterator i = *this;
+        ++*this;
+        return i;
+      }
+      [[nodiscard]] friend bool operator==(Iterator a, Iterator b) noexcept { return a.word == b.word; }
+      [[nodiscard]] friend bool operator!=(Iterator a, Iterator b) noexcept { return a.word != b.word; }
+
+      const uint64_t *word;
+      const char *strings;
+    };
+    using value_type = DocumentElement;
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    [[nodiscard]] size_t size() const noexcept { return count; }
+    [[nodiscard]] bool empty() const noexcept { return count == 0; }
+    [[nodiscard]] Iterator begin() const noexcept { return { first, strings }; }
+    [[nodiscard]] Iterator end() const noexcept { return { last, strings }; }
+    [[nodiscard]] DocumentElement operator[](size_t index) const noexcept { // linear in index, index < size()
+      Iterator i = begin();
+      while (index--)
+        ++i;
+      return *i;
+    }
+
+  private:
+    friend struct DocumentElement;
+    Array(const uint64_t *word, const char *strings) noexcept :
+      first{ word + 2 }, last{ word + detail::getTapePayload(*word) }, count{ static_cast<size_t>(word[1]) },
+      strings{ strings } {}
+
+    const uint64_t *first;
+    const uint64_t *last;
+    size_t count;
+    const char *strings;
+  };
+
+  struct DocumentElement::Object final {
+    using value_type = std::pair<String, DocumentElement>;
+    struct Iterator {
+      using iterator_category = std::input_iterator_tag;
+      using value_type = Object::value_type;
+      using difference_type = std::ptrdiff_t;
+      using pointer = void;
+      using reference = value_type;
+
+      value_type operator*() const noexcept {
+        return { DocumentElement{ word, strings }.asString(), DocumentElement{ word + 2, strings } };
+      }
+      Iterator &operator++() noexcept {
+        word = detail::skipTapeValue(word + 2);
+        return *this;
+      }
+      Iterator operator++(int) noexcept {
+        Iterator i = *this;
+        ++*this;
+        return i;
+      }
+      [[nodiscard]] friend bool operator==(Iterator a, Iterator b) noexcept { return a.word == b.word; }
+      [[nodiscard]] friend bool operator!=(Iterator a, Iterator b) noexcept { return a.word != b.word; }
+
+      const uint64_t *word;
+      const char *strings;
+    };
+    using iterator = Iterator;
+    using const_iterator = Iterator;
+
+    [[nodiscard]] size_t size() const noexcept { return count; }
+    [[nodiscard]] bool empty() const noexcept { return count == 0; }
+    [[nodiscard]] Iterator begin() const noexcept { return { first, strings }; }
+    [[nodiscard]] Iterator end() const noexcept { return { last, strings }; }
+    [[nodiscard]] Iterator find(String key) const noexcept { // linear in size()
+      for (Iterator i = begin(); i != end(); ++i)
+        if (DocumentElement{ i.word, strings }.asString() == key)
+          return i;
+      return end();
+    }
+
+  private:
+    friend struct DocumentElement;
+    Object(const uint64_t *word, const char *strings) noexcept :
+      first{ word + 2 }, last{ word + detail::getTapePayload(*word) }, count{ static_cast<size_t>(word[1]) },
+      strings{ strings } {}
+
+    const uint64_t *first;
+    const uint64_t *last;
+    size_t count;
+    const char *strings;
+  };
+
+  inline DocumentElement::Object DocumentElement::asObject() const {
+    check(isObject());
+    return { word, strings };
+  }
+  inline DocumentElement::Array DocumentElement::asArray() const {
+    check(isArray());
+    return { word, strings };
+  }
+  inline std::optional<DocumentElement> DocumentElement::resolveImpl(size_t index) const {
+    if (isArray()) {
+      if (const Array array{ word, strings }; index < array.size())
+        return array[index];
+    }
+    return std::nullopt;
+  }
+  inline std::optional<DocumentElement> DocumentElement::resolveImpl(String key) const {
+    if (isObject()) {
+      const Object object{ word, strings };
+      if (const auto i = object.find(key); i != object.end())
+        return (*i).second;
+    }
+    return std::nullopt;
+  }
+
+  template<typename F>
+  decltype(auto) visit(F &&f, const DocumentElement &e) {
+    using detail::TapeTag;
+    switch (e.tag()) {
+    case TapeTag::True: return std::forward<F>(f)(true);
+    case TapeTag::False: return std::forward<F>(f)(false);
+    case TapeTag::Integer: return std::forward<F>(f)(e.asInt());
+    case TapeTag::Decimal: return std::forward<F>(f)(e.asDouble());
+    case TapeTag::String: return std::forward<F>(f)(e.asString());
+    case TapeTag::Array: return std::forward<F>(f)(e.asArray());
+    case TapeTag::Object: return std::forward<F>(f)(e.asObject());
+    default: return std::forward<F>(f)(DocumentElement::Null{});
+    }
+  }
+
+  // read-only JSON document stored in two contiguous buffers: tape of values and characters of strings
+  template<typename Allocator>
+  struct BasicDocument {
+    using Tape = std::vector<uint64_t, detail::ReboundAllocator<Allocator, uint64_t>>;
+    using Strings = std::vector<char, detail::ReboundAllocator<Allocator, char>>;
+
+    BasicDocument() = default;
+    explicit BasicDocument(const Allocator &a) : tape{ a }, strings{ a } {}
+
+    [[nodiscard]] DocumentElement root() const noexcept {
+      return tape.empty() ? DocumentElement{} : DocumentElement{ tape.data(), strings.data() };
+    }
+    template<typename... T>
+    [[nodiscard]] auto resolve(T&&... refTokens) const -> decltype(root().resolve(std::forward<T>(refTokens)...)) {
+      return root().resolve(std::forward<T>(refTokens)...);
+    }
+
+  private:
+    friend struct detail::TapeBuilder<Allocator>;
+
+    Tape tape;
+    Strings strings;
+  };
+  using Document = BasicDocument<std::allocator<char>>;
+
+  // JSON Pointer (RFC 6901), e.g. "/foo/0/a~1b", parsed once to be resolved against any number of values or documents;
+  // reference tokens are unescaped ("~1" to '/' and "~0" to '~'), keys are hashed (used by flat objects)
+  // and array indices are converted up front, so resolution does not allocate where keys are looked up
+  // without constructing a key string (see detail::findMember());
+  // throws std::invalid_argument if the pointer is neither empty nor starts with '/' or contains invalid escapes
+  template<typename Allocator>
+  struct BasicJsonPointer {
+    using String = std::basic_string<char, std::char_traits<char>, detail::ReboundAllocator<Allocator, char>>;
+
+    explicit BasicJsonPointer(std::string_view pointer, const Allocator &a = {}) : keys{ a }, tokens{ a } {
+      if (!pointer.empty() && pointer.front() != '/')
+        throw std::invalid_argument{ "JSON Pointer must be empty or start with '/'" };
+      keys.reserve(pointer.size());
+      for (size_t i = 1; i <= pointer.size(); ++i) {
+        const size_t offset = keys.size();
+        for (; i < pointer.size() && pointer[i] != '/'; ++i) {
+          if (pointer[i] != '~') {
+            keys += pointer[i];
+            continue;
+          }
+          if (++i == pointer.size() || (pointer[i] != '0' && pointer[i] != '1'))
+            throw std::invalid_argument{ "JSON Pointer contains invalid escape sequence" };
+          keys += pointer[i] == '0' ? '~' : '/';
+        }
+        const std::string_view key{ keys.data() + offset, keys.size() - offset };
+        tokens.push_back({ offset, key.size(), std::hash<std::string_view>{}(key), toIndex(key) });
+      }
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return tokens.size(); }
+    [[nodiscard]] bool empty() const noexcept { return tokens.empty(); }
+    // unescaped reference token
+    [[nodiscard]] std::string_view operator[](size_t i) const noexcept { return key(tokens[i]); }
+
+    template<typename A, typename P>
+    [[nodiscard]] const BasicValue<A, P> *resolve(const BasicValue<A, P> &value) const noexcept {
+      using Value = BasicValue<A, P>;
+      const Value *v = &value;
+      for (const Token &token : tokens) {
+        if (const auto *array = std::get_if<typename Value::Array>(&v->variant())) {
+          if (token.index >= array->size())
+            return nullptr;
+          v = &(*array)[token.index];
+        }
+        else if (const auto *object = std::get_if<typename Value::Object>(&v->variant())) {
+          const auto i = detail::findMember(*object, key(token), token.hash);
+          if (i == object->end())
+            return nullptr;
+          v = &i->second;
+        }
+        else {
+          return nullptr;
+        }
+      }
+      return v;
+    }
+    template<typename A, typename P>
+    [[nodiscard]] BasicValue<A, P> *resolve(BasicValue<A, P> &value) const noexcept {
+      return const_cast<BasicValue<A, P>*>(resolve(std::as_const(value)));
+    }
+    [[nodiscard]] std::optional<DocumentElement> resolve(DocumentElement element) const {
+      for (const Token &token : tokens) {
+        if (element.isArray()) {
+          const auto array = element.asArray();
+          if (token.index >= array.size())
+            return std::nullopt;
+          element = array[token.index];
+        }
+        else if (element.isObject()) {
+          const auto object = element.asObject();
+          const auto i = object.find(key(token));
+          if (i == object.end())
+            return std::nullopt;
+          element = (*i).second;
+        }
+        else {
+          return std::nullopt;
+        }
+      }
+      return element;
+    }
+    template<typename A>
+    [[nodiscard]] std::optional<DocumentElement> resolve(const BasicDocument<A> &document) const {
+      return resolve(document.root());
+    }
+
+  private:
+    template<typename A>
+    friend struct BasicJsonPointerSet;
+
+    static constexpr size_t NotAnIndex = std::numeric_limits<size_t>::max();
+
+    struct Token {
+      size_t offset;
+      size_t size;
+      size_t hash;
+      size_t index; // NotAnIndex if the token is not a valid array index
+    };
+
+    static size_t toIndex(std::string_view key) noexcept {
+      if (key.empty() || (key.front() == '0' && key.size() > 1)) // leading zeros are not allowed
+        return NotAnIndex;
+      size_t index = 0;
+      const auto [p, error] = std::from_chars(key.data(), key.data() + key.size(), index);
+      return error == std::errc{} && p == key.data() + key.size() ? index : NotAnIndex;
+    }
+    std::string_view key(const Token &token) const noexcept { return { keys.data() + token.offset, token.size }; }
+
+    String keys;
+    std::vector<Token, detail::ReboundAllocator<Allocator, Token>> tokens;
+  };
+  using JsonPointer = BasicJsonPointer<std::allocator<char>>;
+
+  namespace detail {
+    template<typename Allocator>
+    struct JsonPointerSetBuilder;
+    template<typename Allocator, typename Policy>
+    struct ProjectingValueBuilder;
+  }
+
+  // JSON Pointers compiled into a trie to resolve all of them in a single traversal, common prefixes are resolved once;
+  // results are in the order of pointers, the same pointer may be specified several times;
+  // throws std::invalid_argument if any of pointers is malformed (see minjson::BasicJsonPointer)
+  template<typename Allocator>
+  struct BasicJsonPointerSet {
+    template<typename Iterator>
+    BasicJsonPointerSet(Iterator first, Iterator last, const Allocator &a = {}) : keys{ a }, nodes{ a }, duplicates{ a } {
+      nodes.push_back({});
+      for (; first != last; ++first)
+        add(BasicJsonPointer<Allocator>{ *first, a });
+    }
+    BasicJsonPointerSet(std::initializer_list<std::string_view> pointers, const Allocator &a = {}) :
+      BasicJsonPointerSet{ pointers.begin(), pointers.end(), a } {}
+
+    [[nodiscard]] size_t size() const noexcept { return count; }
+    [[nodiscard]] bool empty() const noexcept { return count == 0; }
+
+    template<typename A, typename P>
+    [[nodiscard]] std::vector<const BasicValue<A, P>*> resolve(const BasicValue<A, P> &value) const {
+      std::vector<const BasicValue<A, P>*> results(count, nullptr);
+      resolve(0, value, results.data());
+      copyDuplicates(results.data());
+      return results;
+    }
+    [[nodiscard]] std::vector<std::optional<DocumentElement>> resolve(DocumentElement element) const {
+      std::vector<std::optional<DocumentElement>> results(count);
+      resolve(0, element, results.data());
+      copyDuplicates(results.data());
+      return results;
+    }
+    template<typename A>
+    [[nodiscard]] std::vector<std::optional<DocumentElement>> resolve(const BasicDocument<A> &document) const {
+      return resolve(document.root());
+    }
+
+  private:
+    friend struct detail::JsonPointerSetBuilder<Allocator>;
+    template<typename A, typename P>
+    friend struct detail::ProjectingValueBuilder;
+    using Token = typename BasicJsonPointer<Allocator>::Token;
+
+    static constexpr size_t NoNode = std::numeric_limits<size_t>::max();
+
+    struct Node {
+      Token token = {}; // reference token leading to the node from its parent
+      size_t firstChild = NoNode;
+      size_t nextSibling = NoNode;
+      size_t pointer = NoNode; // position of the first pointer designating the node
+    };
+
+    void add(const BasicJsonPointer<Allocator> &pointer) {
+      size_t node = 0;
+      for (const Token &token : pointer.tokens) {
+        const std::string_view key = pointer.key(token);
+        size_t c = child(node, key);
+        if (c == NoNode) {
+          c = nodes.size();
+          nodes.push_back({ { keys.size(), token.size, token.hash, token.index }, NoNode, nodes[node].firstChild });
+          nodes[node].firstChild = c;
+          keys += key;
+        }
+        node = c;
+      }
+      if (nodes[node].pointer == NoNode)
+        nodes[node].pointer = count;
+      else
+        duplicates.push_back({ count, nodes[node].pointer });
+      ++count;
+    }
+
+    template<typename T>
+    void copyDuplicates(T *results) const noexcept {
+      for (const auto &[pointer, same] : duplicates)
+        results[pointer] = results[same];
+    }
+    std::string_view key(const Node &node) const noexcept {
+      return { keys.data() + node.token.offset, node.token.size };
+    }
+    size_t child(size_t node, std::string_view key) const noexcept {
+      size_t c = nodes[node].firstChild;
+      while (c != NoNode && this->key(nodes[c]) != key)
+        c = nodes[c].nextSibling;
+      return c;
+    }
+    size_t child(size_t node, size_t index) const noexcept {
+      size_t c = nodes[node].firstChild;
+      while (c != NoNode && nodes[c].token.index != index)
+        c = nodes[c].nextSibling;
+      return c;
+    }
+
+    template<typename Value>
+    void resolve(size_t node, const Value &value, const Value **results) const noexcept {
+      if (nodes[node].pointer != NoNode)
+        results[nodes[node].pointer] = &value;
+      if (nodes[node].firstChild == NoNode)
+        return;
+      if (const auto *array = std::get_if<typename Value::Array>(&value.variant())) {
+        for (size_t c = nodes[node].firstChild; c != NoNode; c = nodes[c].nextSibling) {
+          if (nodes[c].token.index < array->size())
+            resolve(c, (*array)[nodes[c].token.index], results);
+        }
+      }
+      else if (const auto *object = std::get_if<typename Value::Object>(&value.variant())) {
+        for (size_t c = nodes[node].firstChild; c != NoNode; c = nodes[c].nextSibling) {
+          if (const auto i = detail::findMember(*object, key(nodes[c]), nodes[c].token.hash); i != object->end())
+            resolve(c, i->second, results);
+        }
+      }
+    }
+    // elements of arrays and members of objects are iterated once for all children
+    void resolve(size_t node, DocumentElement element, std::optional<DocumentElement> *results) const {
+      if (nodes[node].pointer != NoNode)
+        results[nodes[node].pointer] = element;
+      if (nodes[node].firstChild == NoNode)
+        return;
+      size_t remaining = 0; // children not found yet
+      for (size_t c = nodes[node].firstChild; c != NoNode; c = nodes[c].nextSibling)
+        remaining += !element.isArray() || nodes[c].token.index != BasicJsonPointer<Allocator>::NotAnIndex;
+      if (element.isArray()) {
+        const auto array = element.asArray();
+        size_t index = 0;
+        for (auto i = array.begin(); remaining != 0 && i != array.end(); ++i) {
+          if (const size_t c = child(node, index++); c != NoNode) {
+            resolve(c, *i, results);
+            --remaining;
+          }
+        }
+      }
+      else if (element.isObject()) {
+        const auto object = element.asObject();
+        for (auto i = object.begin(); remaining != 0 && i != object.end(); ++i) {
+          const auto &[k, e] = *i;
+          if (const size_t c = child(node, k); c != NoNode) {
+            resolve(c, e, results);
+            --remaining;
+          }
+        }
+      }
+    }
+
+    typename BasicJsonPointer<Allocator>::String keys;
+    std::vector<Node, detail::ReboundAllocator<Allocator, Node>> nodes; // root is the first one
+    std::vector<std::pair<size_t, size_t>, detail::ReboundAllocator<Allocator, std::pair<size_t, size_t>>> duplicates;
+    size_t count = 0;
+  };
+  using JsonPointerSet = BasicJsonPointerSet<std::allocator<char>>;
+
+
+  enum class Escape {
+    Default,
+    NonAscii
+  };
+  enum class Utf8Validation {
+    IgnoreInvalidUtf8CodeUnits, // a.k.a. "garbage in - garbage out"
+    FailOnInvalidUtf8CodeUnits  // operation fails on first invalid UTF-8 code point/code unit
+  };
+  enum class HexDigitsCase {
+    Lower,
+    Upper
+  };
+
+  namespace detail {
+    inline unsigned countTrailingZeros(uint64_t x) { // x must not be 0
+#if defined(_MSC_VER) && !defined(__clang__)
+      unsigned long i;
+#if defined(_M_X64) || defined(_M_ARM64)
+      _BitScanForward64(&i, x);
+#else
+      if (!_BitScanForward(&i, static_cast<unsigned long>(x))) {
+        _BitScanForward(&i, static_cast<unsigned long>(x >> 32));
+        i += 32;
+      }
+#endif
+      return static_cast<unsigned>(i);
+#else
+      return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+    }
+    inline unsigned countLeadingZeros(uint64_t x) { // x must not be 0
+#if defined(_MSC_VER) && !defined(__clang__)
+      unsigned long i;
+#if defined(_M_X64) || defined(_M_ARM64)
+      _BitScanReverse64(&i, x);
+#else
+      if (_BitScanReverse(&i, static_cast<unsigned long>(x >> 32)))
+        i += 32;
+      else
+        _BitScanReverse(&i, static_cast<unsigned long>(x));
+#endif
+      return 63 - static_cast<unsigned>(i);
+#else
+      return static_cast<unsigned>(__builtin_clzll(x));
+#endif
+    }
+
+#if defined(MINJSONCPP_SIMD_AVX2)
+#define MINJSONCPP_SIMD
+    struct SimdVector final {
+      static constexpr size_t Size = 32;
+      static SimdVector load(const char *p) { return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)) }; }
+      SimdVector equals(char c) const { return { _mm256_cmpeq_epi8(v, _mm256_set1_epi8(c)) }; }
+      SimdVector isControlCharacter() const { // unsigned v <= 0x1f
+        return { _mm256_cmpeq_epi8(_mm256_min_epu8(v, _mm256_set1_epi8('\x1f')), v) };
+      }
+      SimdVector greaterOrEqual(char c) const { // unsigned comparison
+        return { _mm256_cmpeq_epi8(_mm256_max_epu8(v, _mm256_set1_epi8(c)), v) };
+      }
+      SimdVector isUtf8ContinuationByte() const { return { _mm256_cmpgt_epi8(_mm256_set1_epi8(-64), v) }; }
+      SimdVector operator|(SimdVector other) const { return { _mm256_or_si256(v, other.v) }; }
+      SimdVector operator^(SimdVector other) const { return { _mm256_xor_si256(v, other.v) }; }
+      uint32_t mask() const { return static_cast<uint32_t>(_mm256_movemask_epi8(v)); } // bits are set for bytes >= 0x80
+      __m256i v;
+    };
+#elif defined(MINJSONCPP_SIMD_SSE2)
+#define MINJSONCPP_SIMD
+    struct SimdVector final {
+      static constexpr size_t Size = 16;
+      static SimdVector load(const char *p) { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)) }; }
+      SimdVector equals(char c) const { return { _mm_cmpeq_epi8(v, _mm_set1_epi8(c)) }; }
+      SimdVector isControlCharacter() const { // unsigned v <= 0x1f
+        return { _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8('\x1f')), v) };
+      }
+      SimdVector greaterOrEqual(char c) const { // unsigned comparison
+        return { _mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8(c)), v) };
+      }
+      SimdVector isUtf8ContinuationByte() const { return { _mm_cmplt_epi8(v, _mm_set1_epi8(-64)) }; }
+      SimdVector operator|(SimdVector other) const { return { _mm_or_si128(v, other.v) }; }
+      SimdVector operator^(SimdVector other) const { return { _mm_xor_si128(v, other.v) }; }
+      uint32_t mask() const { return static_cast<uint32_t>(_mm_movemask_epi8(v)); } // bits are set for bytes >= 0x80
+      __m128i v;
+    };
+#elif defined(MINJSONCPP_SIMD_NEON)
+#define MINJSONCPP_SIMD
+    struct SimdVector final {
+      static constexpr size_t Size = 16;
+      static SimdVector load(const char *p) { return { vld1q_u8(reinterpret_cast<const uint8_t*>(p)) }; }
+      SimdVector equals(char c) const { return { vceqq_u8(v, vdupq_n_u8(static_cast<uint8_t>(c))) }; }
+      SimdVector isControlCharacter() const { return { vcltq_u8(v, vdupq_n_u8(0x20u)) }; }
+      SimdVector greaterOrEqual(char c) const { return { vcgeq_u8(v, vdupq_n_u8(static_cast<uint8_t>(c))) }; }
+      SimdVector isUtf8ContinuationByte() const {
+        return { vceqq_u8(vandq_u8(v, vdupq_n_u8(0xc0u)), vdupq_n_u8(0x80u)) };
+      }
+      SimdVector operator|(SimdVector other) const { return { vorrq_u8(v, other.v) }; }
+      SimdVector operator^(SimdVector other) const { return { veorq_u8(v, other.v) }; }
+      uint32_t mask() const { // bits are set for bytes >= 0x80
+        static constexpr int8_t shifts[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 4, 5, 6, 7 };
+        const uint8x16_t bits = vshlq_u8(vshrq_n_u8(v, 7), vld1q_s8(shifts));
+        return vaddv_u8(vget_low_u8(bits)) | static_cast<uint32_t>(vaddv_u8(vget_high_u8(bits))) << 8;
+      }
+      uint8x16_t v;
+    };
+#endif
+
+    inline char matchCommonCharacterToEscape(char c) {
+      switch (c) {
+      case '\b': return 'b';
+      case '\t': return 't';
+      case '\n': return 'n';
+      case '\f': return 'f';
+      case '\r': return 'r';
+      case '\"': return '\"';
+      case '\\': return '\\';
+      }
+      return '\0';
+    }
+    inline bool isControlCharacter(char c) { return (c & '\xe0') == 0; }
+    // returns pointer to the first '"', '\\', control character (or non-ASCII character if requested), or end
+    template<bool stopAtNonAscii = false>
+    const char *skipPlainStringCharacters(const char *begin, const char *end) {
+#if defined(MINJSONCPP_SIMD)
+      for (; static_cast<size_t>(end - begin) >= SimdVector::Size; begin += SimdVector::Size) {
+        const auto v = SimdVector::load(begin);
+        auto special = v.equals('\"') | v.equals('\\') | v.isControlCharacter();
+        if constexpr (stopAtNonAscii)
+          special = special | v; // high bit is set for non-ASCII characters
+        if (const uint32_t mask = special.mask())
+          return begin + countTrailingZeros(mask);
+      }
+#else
+      constexpr uint64_t ones = 0x0101010101010101u, highBits = 0x8080808080808080u;
+      for (; end - begin >= 8; begin += 8) {
+        uint64_t w;
+        std::memcpy(&w, begin, 8);
+        const uint64_t quotes = w ^ ones * '\"', backslashes = w ^ ones * '\\';
+        // high bit is set for zero bytes and for bytes < 0x20 (can have false positives after the first one)
+        if (((quotes - ones) & ~quotes | (backslashes - ones) & ~backslashes | (w - ones * 0x20u) & ~w |
+             (stopAtNonAscii ? w : 0)) & highBits)
+          break;
+      }
+#endif
+      while (begin != end && *begin != '\"' && *begin != '\\' && !isControlCharacter(*begin) &&
+             !(stopAtNonAscii && (*begin & '\x80')))
+        ++begin;
+      return begin;
+    }
+    template<size_t N>
+    bool isUtf8CodeUnit(char c) {
+      constexpr uint8_t mask = static_cast<uint8_t>(0xffu << (7 - N));
+      constexpr uint8_t pattern = static_cast<uint8_t>(0xffu << (8 - N));
+      return (mask & static_cast<uint8_t>(c)) == pattern;
+    }
+    inline size_t getExpectedUtf8CodePointSize(char c) {
       if (isUtf8CodeUnit<2>(c)) return 2;
       if (isUtf8CodeUnit<3>(c)) return 3;
       if (isUtf8CodeUnit<4>(c)) return 4;
@@ -292,6 +1800,61 @@ namespace minjson {
         return expectedSize;
       return 0;
     }
+    inline const char *findInvalidUtf8CodePointScalar(const char *begin, const char *end) {
+      while (begin != end) {
+#if !defined(MINJSONCPP_SIMD)
+        for (uint64_t w; end - begin >= 8 && (std::memcpy(&w, begin, 8), (w & 0x8080808080808080u) == 0);)
+          begin += 8;
+        if (begin == end)
+          break;
+#endif
+        if (*begin & '\x80') {
+          const size_t codePointSize = detectUtf8CodePointSize(begin, end);
+          if (codePointSize == 0)
+            return begin;
+          begin += codePointSize;
+        }
+        else {
+          ++begin;
+        }
+      }
+      return end;
+    }
+    // Returns pointer to the first invalid UTF-8 code point, or end.
+    // Follows the same rules as detectUtf8CodePointSize(): every byte is checked to be a continuation byte
+    // if and only if one of the 3 preceding bytes is a lead byte expecting it, which is checked for whole vectors.
+    inline const char *findInvalidUtf8CodePoint(const char *begin, const char *end) {
+#if defined(MINJSONCPP_SIMD)
+      const char *i = begin;
+      while (i != end && i - begin < 3) { // previous 3 bytes are loaded along with each vector
+        if (*i & '\x80') {
+          const size_t codePointSize = detectUtf8CodePointSize(i, end);
+          if (codePointSize == 0)
+            return i;
+          i += codePointSize;
+        }
+        else {
+          ++i;
+        }
+      }
+      for (; static_cast<size_t>(end - i) >= SimdVector::Size; i += SimdVector::Size) {
+        const auto v = SimdVector::load(i);
+        const auto mustBeContinuationByte = SimdVector::load(i - 1).greaterOrEqual('\xc0') |
+                                            SimdVector::load(i - 2).greaterOrEqual('\xe0') |
+                                            SimdVector::load(i - 3).greaterOrEqual('\xf0');
+        if (((v.isUtf8ContinuationByte() ^ mustBeContinuationByte) | v.greaterOrEqual('\xf8')).mask())
+          break;
+      }
+      // moving back to the start of the code point that may cross the vector boundary
+      while (i != begin && (i[-1] & '\xc0') == '\x80')
+        --i;
+      if (i != begin && (i[-1] & '\xc0') == '\xc0')
+        --i;
+      return findInvalidUtf8CodePointScalar(i, end);
+#else
+      return findInvalidUtf8CodePointScalar(begin, end);
+#endif
+    }
     template<size_t Size>
     inline constexpr uint32_t LowerBitsMask = (1u << Size) - 1u;
     template<typename Int_t, size_t Size0, size_t... Size1, typename T0, typename... T1>
@@ -364,9 +1927,12 @@ namespace minjson {
       const char *write(const char *begin, const char *end,
                         Escape escape, Utf8Validation validation) {
         if (escape == Escape::Default) {
-          return validation == Utf8Validation::FailOnInvalidUtf8CodeUnits ?
-            writeImpl<ValidateUtf8>(begin, end) :
-            writeImpl<Default>(begin, end);
+          if (validation == Utf8Validation::FailOnInvalidUtf8CodeUnits) {
+            const char *invalid = findInvalidUtf8CodePoint(begin, end);
+            writeImpl<Default>(begin, invalid);
+            return invalid;
+          }
+          return writeImpl<Default>(begin, end);
         }
         return validation == Utf8Validation::FailOnInvalidUtf8CodeUnits ?
           writeImpl<EscapeNonAsciiAndValidateUtf8>(begin, end) :
@@ -374,7 +1940,7 @@ namespace minjson {
       }
 
     private:
-      enum EscapeMode {
+      enum EscapeMode { // validation without escaping is done up front, see write()
         Default = 0,
         EscapeNonAscii = 1,
         ValidateUtf8 = 1 << 1,
@@ -383,55 +1949,42 @@ namespace minjson {
       template<EscapeMode escapeMode>
       const char *writeImpl(const char *begin, const char *end) {
         pendingBegin = begin;
-        while (pendingBegin != end) {
-          const char *i = pendingBegin;
-          for (;;) {
-            if (const char esc = matchCommonCharacterToEscape(*i)) {
-              writeAndAdvance(i, 1, escaped.decorate(esc));
-              break;
-            }
-            if (isControlCharacter(*i)) { // characters 0x0..0x1f must be escaped
-              writeAndAdvance(i, 1, escaped.get(*i));
-              break;
-            }
-            if constexpr (escapeMode != Default) {
-              if (*i & '\x80') { // handling UTF-8 multibyte code point
-                const size_t codePointSize = detectUtf8CodePointSize(i, end);
-                if constexpr (escapeMode & EscapeNonAscii) {
-                  if (codePointSize != 0) {
-                    writeAndAdvance(i, codePointSize, escaped.getForMultiByteUtf8(i, codePointSize));
-                    break; // for (;;)
-                  }
-                  else if constexpr (escapeMode & ValidateUtf8) {
-                    return i;
-                  }
-                }
-                else /* escapeMode == ValidateUtf8 */ {
-                  if (codePointSize == 0)
-                    return i;
-                  i += codePointSize;
-                  goto CheckEnd;
-                }
-              }
-            }
-            ++i;
-          CheckEnd:
-            if (i == end) {
+        const char *i = begin;
+        for (;;) {
+          i = skipPlainStringCharacters<escapeMode != Default>(i, end);
+          if (i == end) {
+            if (pendingBegin != end)
               writePending(end);
-              return end;
+            return end;
+          }
+          if (const char esc = matchCommonCharacterToEscape(*i)) {
+            i = writeAndAdvance(i, 1, escaped.decorate(esc));
+          }
+          else if (isControlCharacter(*i)) { // characters 0x0..0x1f must be escaped
+            i = writeAndAdvance(i, 1, escaped.get(*i));
+          }
+          else if constexpr (escapeMode != Default) { // escaping UTF-8 multibyte code point
+            const size_t codePointSize = detectUtf8CodePointSize(i, end);
+            if (codePointSize == 0) {
+              if constexpr (escapeMode & ValidateUtf8)
+                return i;
+              ++i;
             }
-          } // for (;;)
-        } // while ()
-        return end;
-      }
-      void writePending(const char *i) {
+            else {
+              i = writeAndAdvance(i, codePointSize, escaped.getForMultiByteUtf8(i, codePointSize));
+            }
+          }
+        }
+      }
+      void writePending(const char *i) {
         sink(std::string_view{ pendingBegin, static_cast<size_t>(i - pendingBegin) });
       }
-      void writeAndAdvance(const char *i, size_t inc, std::string_view escapeSequence) {
+      const char *writeAndAdvance(const char *i, size_t inc, std::string_view escapeSequence) {
         if (pendingBegin != i)
           writePending(i);
         pendingBegin = i + inc;
         sink(escapeSequence);
+        return pendingBegin;
       }
 
       Sink &&sink;
@@ -445,10 +1998,116 @@ namespace minjson {
       String &s;
     };
 
-    struct StdOStreamSink final {
-      void operator()(std::string_view v) const { s.write(v.data(), v.size()); }
-      std::ostream &s;
+    struct SizeCountingSink final {
+      void operator()(std::string_view t) { size += t.size(); }
+      size_t &size;
+    };
+
+    // writes as much as fits into the buffer, counts everything
+    struct CharBufferSink final {
+      void operator()(std::string_view t) {
+        const size_t n = std::min(t.size(), static_cast<size_t>(end - p));
+        if (n != 0) {
+          std::memcpy(p, t.data(), n);
+          p += n;
+        }
+        size += t.size();
+      }
+      char *p;
+      char *const end;
+      size_t size = 0;
     };
+
+  }
+
+  struct StdOStreamSink final {
+    void operator()(std::string_view v) const { s.write(v.data(), v.size()); }
+    std::ostream &s;
+  };
+#if defined(MINJSONCPP_POSIX)
+  // writes to a file descriptor (e.g. a file, a pipe or a socket), throws std::system_error on failure
+  struct FileDescriptorSink final {
+    void operator()(std::string_view v) const {
+      while (!v.empty()) {
+        const ssize_t written = ::write(fd, v.data(), v.size());
+        if (written == -1) {
+          if (errno == EINTR)
+            continue;
+          throw std::system_error{ errno, std::generic_category(), "failed to write" };
+        }
+        v.remove_prefix(static_cast<size_t>(written));
+      }
+    }
+    int fd;
+  };
+#endif
+
+  // accumulates small parts in a fixed size buffer and passes them to the inner sink in big chunks,
+  // parts that don't fit into the buffer go to the inner sink directly;
+  // remaining contents are flushed on destruction (exceptions are swallowed then, call flush() to get them)
+  template<typename Sink, size_t BufferSize = 8 * 1024>
+  class BufferedSink final {
+  public:
+    static_assert(BufferSize >= 512, "serializer writes numbers directly into the buffer");
+
+    explicit BufferedSink(Sink sink) : m_sink{ std::forward<Sink>(sink) } {}
+    BufferedSink(const BufferedSink&) = delete;
+    BufferedSink &operator=(const BufferedSink&) = delete;
+    ~BufferedSink() {
+      try {
+        flush();
+      }
+      catch (...) {
+      }
+    }
+
+    void operator()(std::string_view s) {
+      if (s.size() > BufferSize - m_size) {
+        flush();
+        if (s.size() >= BufferSize) {
+          m_sink(s);
+          return;
+        }
+      }
+      char *const p = m_buffer + m_size;
+      if (s.size() <= 8) // most parts are short, avoiding call to memcpy()
+        for (size_t i = 0; i < s.size(); ++i)
+          p[i] = s[i];
+      else
+        std::memcpy(p, s.data(), s.size());
+      m_size += s.size();
+    }
+    // space for at least size (up to BufferSize) characters to be written directly into the buffer,
+    // the amount actually written is reported with commit()
+    [[nodiscard]] char *reserve(size_t size) {
+      if (size > BufferSize - m_size)
+        flush();
+      return m_buffer + m_size;
+    }
+    void commit(size_t size) noexcept { m_size += size; }
+    void flush() {
+      if (m_size != 0) {
+        const size_t size = m_size;
+        m_size = 0;
+        m_sink(std::string_view{ m_buffer, size });
+      }
+    }
+
+    [[nodiscard]] Sink &sink() noexcept { return m_sink; }
+
+  private:
+    Sink m_sink;
+    size_t m_size = 0;
+    char m_buffer[BufferSize];
+  };
+  template<typename Sink>
+  BufferedSink(Sink) -> BufferedSink<Sink>;
+
+  namespace detail {
+    template<typename Sink>
+    inline constexpr bool IsBufferedSink = false;
+    template<typename Sink, size_t BufferSize>
+    inline constexpr bool IsBufferedSink<BufferedSink<Sink, BufferSize>> = true;
   }
 
   namespace impl {
@@ -503,6 +2162,18 @@ namespace minjson {
       bool beforeArrayMemberSeparator = false;
       bool afterArrayMemberSeparator = true;
     } newline{};
+    struct DecimalOptions {
+      enum class Notation {
+        Auto, // the shorter of fixed and scientific, fixed if equal (the same as std::to_chars())
+        Fixed,
+        Scientific
+      } notation = {};
+      int precision = 0; // maximum number of significant digits, 0 means the shortest representation that round trips
+      bool decimalPointForIntegral = false; // e.g. 42.0 instead of 42 (fixed notation only)
+      bool exponentPlusSign = true; // e.g. 1e+22 instead of 1e22
+      unsigned minExponentDigits = 2; // exponent is padded with zeros, e.g. 1e-07 instead of 1e-7 (up to 3)
+      char exponentChar = 'e';
+    } decimal{};
     bool sortObjectKeys = false;
     std::string_view nullLiteral = NullLiteral;
     std::string_view falseLiteral = FalseLiteral;
@@ -528,13 +2199,182 @@ namespace minjson {
   };
 
   namespace detail {
+    struct DecimalNumber {
+      uint64_t significand;
+      int exponent;
+    };
+    // shortest decimal significand * 10^exponent that converts back to the same double (the closest if there are
+    // several), Schubfach algorithm by Raffaello Giulietti; bits are of a finite non-zero double, sign is ignored
+    // (defined after the table of powers of five shared with the parser)
+    inline DecimalNumber toShortestDecimal(uint64_t bits);
+    inline unsigned countDecimalDigits(uint64_t n) {
+      static constexpr uint64_t powersOfTen[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000,
+                                                  1000000000, 10000000000, 100000000000, 1000000000000,
+                                                  10000000000000, 100000000000000, 1000000000000000,
+                                                  10000000000000000, 100000000000000000, 1000000000000000000,
+                                                  10000000000000000000u };
+      n |= 1; // doesn't change the count but avoids 0
+      const unsigned t = (64 - countLeadingZeros(n)) * 1233 >> 12; // 1233 / 4096 ~ log10(2)
+      return t + (n >= powersOfTen[t] ? 1 : 0);
+    }
+    // fills [begin, end) with the lowest decimal digits of n
+    inline void writeDecimalDigits(char *begin, char *end, uint64_t n) {
+      static constexpr char pairs[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                                      "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                                      "8081828384858687888990919293949596979899";
+      const auto writeChunk = [](char *begin, char *end, uint32_t n) { // 32 bit arithmetic is cheaper
+        for (; end - begin >= 2; n /= 100) {
+          end -= 2;
+          std::memcpy(end, pairs + 2 * (n % 100), 2);
+        }
+        if (begin != end)
+          *begin = static_cast<char>('0' + n % 10);
+      };
+      for (; end - begin > 8; n /= 100000000) { // independent chunks of 8 digits
+        end -= 8;
+        writeChunk(end, end + 8, static_cast<uint32_t>(n % 100000000));
+      }
+      writeChunk(begin, end, static_cast<uint32_t>(n));
+    }
+    // writes exact value of integer high * 2^64 + low
+    inline char *writeDecimalDigits(char *p, uint64_t high, uint64_t low) {
+      uint32_t limbs[] = { static_cast<uint32_t>(high >> 32), static_cast<uint32_t>(high),
+                           static_cast<uint32_t>(low >> 32), static_cast<uint32_t>(low) };
+      uint32_t chunks[5]; // of 9 digits, from the least significant
+      size_t chunkCount = 0;
+      for (bool isZero = false; !isZero;) {
+        uint64_t remainder = 0;
+        isZero = true;
+        for (uint32_t &limb : limbs) {
+          const uint64_t n = remainder << 32 | limb;
+          limb = static_cast<uint32_t>(n / 1000000000);
+          remainder = n % 1000000000;
+          isZero = isZero && limb == 0;
+        }
+        chunks[chunkCount++] = static_cast<uint32_t>(remainder);
+      }
+      const unsigned digits = countDecimalDigits(chunks[--chunkCount]);
+      writeDecimalDigits(p, p + digits, chunks[chunkCount]);
+      p += digits;
+      while (chunkCount) {
+        writeDecimalDigits(p, p + 9, chunks[--chunkCount]);
+        p += 9;
+      }
+      return p;
+    }
+
+    // enough for fixed notation of any double, e.g. the smallest subnormal number
+    inline constexpr size_t DecimalBufferSize = 352;
+    inline char *writeDecimal(char *p, double d, const SerializationOptions::DecimalOptions &options) {
+      using Notation = SerializationOptions::DecimalOptions::Notation;
+      uint64_t bits;
+      std::memcpy(&bits, &d, sizeof(bits));
+      if (bits >> 63)
+        *p++ = '-';
+      const int biasedExponent = static_cast<int>(bits >> 52 & 0x7FF);
+      if (biasedExponent == 0x7FF) { // not representable in JSON, written the same way as by std::to_chars()
+        std::memcpy(p, bits << 12 ? "nan" : "inf", 3);
+        return p + 3;
+      }
+      DecimalNumber decimal{};
+      if (bits << 1 == 0) {
+        // zero
+      }
+      else if (options.precision > 0) { // correctly rounded, not necessarily shortest
+        char buf[32];
+        const char *const end = std::to_chars(buf, buf + sizeof(buf), d < 0 ? -d : d, std::chars_format::scientific,
+                                              std::min(options.precision, 17) - 1).ptr;
+        const char *i = buf;
+        for (; *i != 'e'; ++i)
+          if (*i != '.')
+            decimal.significand = decimal.significand * 10 + static_cast<uint64_t>(*i - '0');
+        std::from_chars(i + (i[1] == '+' ? 2 : 1), end, decimal.exponent);
+        decimal.exponent -= static_cast<int>(countDecimalDigits(decimal.significand)) - 1;
+      }
+      else {
+        decimal = toShortestDecimal(bits);
+      }
+      if (decimal.significand)
+        for (; decimal.significand % 10 == 0; decimal.significand /= 10)
+          ++decimal.exponent;
+      const int digits = static_cast<int>(countDecimalDigits(decimal.significand));
+      const int scientificExponent = digits - 1 + decimal.exponent;
+      const unsigned scientificExponentAbs = static_cast<unsigned>(std::abs(scientificExponent));
+      const int exponentDigits = static_cast<int>(std::max(countDecimalDigits(scientificExponentAbs),
+                                                           std::min(options.minExponentDigits, 3u)));
+      const bool exponentSign = scientificExponent < 0 || options.exponentPlusSign;
+      bool isFixed = options.notation == Notation::Fixed;
+      if (options.notation == Notation::Auto) {
+        const int fixedSize = decimal.exponent >= 0 ? digits + decimal.exponent + (options.decimalPointForIntegral ? 2 : 0)
+                            : -decimal.exponent < digits ? digits + 1
+                            : 2 - decimal.exponent;
+        const int scientificSize = digits + (digits > 1 ? 1 : 0) + 1 + exponentSign + exponentDigits;
+        isFixed = fixedSize <= scientificSize;
+      }
+      if (isFixed) {
+        if (decimal.exponent >= 0) {
+          const int q = biasedExponent - 1075;
+          if (decimal.exponent > 0 && options.precision <= 0 && q > 0 && q <= 128 - 53) {
+            // written exactly like printf() does, trailing digits are not necessarily zeros
+            const uint64_t c = bits << 12 >> 12 | uint64_t{ 1 } << 52;
+            p = q < 64 ? writeDecimalDigits(p, c >> (64 - q), c << q) : writeDecimalDigits(p, c << (q - 64), 0);
+          }
+          else {
+            writeDecimalDigits(p, p + digits, decimal.significand);
+            p += digits;
+            std::memset(p, '0', static_cast<size_t>(decimal.exponent));
+            p += decimal.exponent;
+          }
+          if (options.decimalPointForIntegral) {
+            std::memcpy(p, ".0", 2);
+            p += 2;
+          }
+        }
+        else if (-decimal.exponent < digits) {
+          const int integralDigits = digits + decimal.exponent;
+          writeDecimalDigits(p, p + digits, decimal.significand);
+          std::memmove(p + integralDigits + 1, p + integralDigits, static_cast<size_t>(-decimal.exponent));
+          p[integralDigits] = '.';
+          p += digits + 1;
+        }
+        else {
+          const int zeros = -decimal.exponent - digits;
+          std::memcpy(p, "0.", 2);
+          std::memset(p + 2, '0', static_cast<size_t>(zeros));
+          p += 2 + zeros;
+          writeDecimalDigits(p, p + digits, decimal.significand);
+          p += digits;
+        }
+        return p;
+      }
+      writeDecimalDigits(p + 1, p + digits + 1, decimal.significand);
+      p[0] = p[1];
+      if (digits > 1) {
+        p[1] = '.';
+        p += digits + 1;
+      }
+      else {
+        ++p;
+      }
+      *p++ = options.exponentChar;
+      if (exponentSign)
+        *p++ = scientificExponent < 0 ? '-' : '+';
+      writeDecimalDigits(p, p + exponentDigits, scientificExponentAbs);
+      return p + exponentDigits;
+    }
+
     enum class SerializationMode {
       WithoutIndentation,
       WithIndentation
     };
-    template<typename Sink, typename Allocator, SerializationMode serializationMode>
+    template<typename Object, typename = void>
+    inline constexpr bool IsSortedByKey = false;
+    template<typename Object> // e.g. std::map
+    inline constexpr bool IsSortedByKey<Object, std::void_t<typename Object::key_compare>> = true;
+    template<typename Key, typename Value, typename Allocator>
+    inline constexpr bool IsSortedByKey<SortedFlatObject<Key, Value, Allocator>> = true;
+    template<typename Sink, typename Value, SerializationMode serializationMode>
     struct SerializingVisitor final {
-      using Value = BasicValue<Allocator>;
       void operator()(const typename Value::Object &o) {
         if (o.empty() && !options.emptyObject.empty()) {
           sink(options.emptyObject);
@@ -547,10 +2387,15 @@ namespace minjson {
           if (o.size() == 1) {
             writeObjectMember(*o.begin());
           }
-          else if (options.sortObjectKeys) {
-            std::vector<std::reference_wrapper<const typename Value::Object::value_type>> items{ o.begin(), o.end() };
-            std::sort(items.begin(), items.end(),
-                      [](auto a, auto b) { return std::get<0>(a.get()) < std::get<0>(b.get()); });
+          else if (options.sortObjectKeys && !IsSortedByKey<typename Value::Object>) {
+            using Member = typename Value::Object::value_type;
+            // members of documents are not stored as such, they are cheap to copy
+            using Item = std::conditional_t<std::is_reference_v<decltype(*o.begin())>,
+              std::reference_wrapper<const Member>, Member>;
+            std::vector<Item> items{ o.begin(), o.end() };
+            std::sort(items.begin(), items.end(), [](const Item &a, const Item &b) {
+              return std::get<0>(static_cast<const Member&>(a)) < std::get<0>(static_cast<const Member&>(b));
+                      });
             writeObjectMembers(items.begin(), items.end());
           }
           else {
@@ -656,42 +2501,155 @@ namespace minjson {
       }
       template<typename T>
       void writeNumber(T n) {
-        char buf[24];
-        const auto result = std::to_chars(buf, buf + sizeof(buf), n);
-        sink(std::string_view{ buf, static_cast<size_t>(result.ptr - buf) });
+        if constexpr (IsBufferedSink<std::remove_reference_t<Sink>>) {
+          char *const p = sink.reserve(24);
+          sink.commit(static_cast<size_t>(std::to_chars(p, p + 24, n).ptr - p));
+        }
+        else {
+          char buf[24];
+          const auto result = std::to_chars(buf, buf + sizeof(buf), n);
+          sink(std::string_view{ buf, static_cast<size_t>(result.ptr - buf) });
+        }
+      }
+      void writeNumber(double d) {
+        if constexpr (IsBufferedSink<std::remove_reference_t<Sink>>) {
+          // only fixed notation can be long, e.g. for the smallest subnormal number
+          using Notation = SerializationOptions::DecimalOptions::Notation;
+          char *const p = sink.reserve(options.decimal.notation == Notation::Fixed ? DecimalBufferSize : 32);
+          sink.commit(static_cast<size_t>(writeDecimal(p, d, options.decimal) - p));
+        }
+        else {
+          char buf[DecimalBufferSize];
+          sink(std::string_view{ buf, static_cast<size_t>(writeDecimal(buf, d, options.decimal) - buf) });
+        }
       }
     };
-  }
 
-  namespace impl {
-    template<typename Sink, typename Allocator>
-    void serialize(Sink &&sink,
-                   const BasicValue<Allocator> &v,
-                   const SerializationOptions &options,
-                   size_t initialIndentation = 0) {
+    template<typename Sink, typename Value>
+    void serialize(Sink &&sink, const Value &v, const SerializationOptions &options, size_t initialIndentation) {
       if (options.indent || !options.newline.separator.empty()) {
-        using Visitor = detail::SerializingVisitor<Sink, Allocator, detail::SerializationMode::WithIndentation>;
+        using Visitor = SerializingVisitor<Sink, Value, SerializationMode::WithIndentation>;
         const std::string_view newlineSeparator = options.newline.separator.empty() ? "\n" : options.newline.separator;
         visit(Visitor{ std::forward<Sink>(sink), options, newlineSeparator, initialIndentation }, v);
       }
       else {
-        using Visitor = detail::SerializingVisitor<Sink, Allocator, detail::SerializationMode::WithoutIndentation>;
+        using Visitor = SerializingVisitor<Sink, Value, SerializationMode::WithoutIndentation>;
         visit(Visitor{ std::forward<Sink>(sink), options }, v);
       }
     }
   }
 
+  namespace impl {
+    template<typename Sink, typename Allocator, typename Policy>
+    void serialize(Sink &&sink,
+                   const BasicValue<Allocator, Policy> &v,
+                   const SerializationOptions &options,
+                   size_t initialIndentation = 0) {
+      detail::serialize(std::forward<Sink>(sink), v, options, initialIndentation);
+    }
+    template<typename Sink>
+    void serialize(Sink &&sink,
+                   const DocumentElement &e,
+                   const SerializationOptions &options,
+                   size_t initialIndentation = 0) {
+      detail::serialize(std::forward<Sink>(sink), e, options, initialIndentation);
+    }
+  }
+
+  enum class StringAllocation {
+    Grow,     // the string grows as serialized parts are appended
+    ExactSize // the exact size is computed first (by serializing twice), then the string is allocated once
+  };
+
+  namespace detail {
+    template<typename Value>
+    size_t serializedSize(const Value &v, const SerializationOptions &o) {
+      size_t size = 0;
+      serialize(SizeCountingSink{ size }, v, o, 0);
+      return size;
+    }
+    template<typename String, typename Value>
+    String serializeToString(const Value &v,
+                             const SerializationOptions &o,
+                             StringAllocation allocation,
+                             const typename String::allocator_type &allocator = {}) {
+      String s{ allocator };
+      if (allocation == StringAllocation::ExactSize)
+        s.reserve(serializedSize(v, o));
+      serialize(StringSink<String>{ s }, v, o, 0);
+      return s;
+    }
+    template<typename Value>
+    size_t serializeToBuffer(char *buffer, size_t size, const Value &v, const SerializationOptions &o) {
+      CharBufferSink sink{ buffer, buffer + size };
+      serialize(sink, v, o, 0);
+      return sink.size;
+    }
+  }
+
+  template<typename Allocator, typename Policy>
+  void serializeToStream(std::ostream &s, const BasicValue<Allocator, Policy> &v, const SerializationOptions &o = {}) {
+    impl::serialize(BufferedSink<StdOStreamSink>{ { s } }, v, o);
+  }
+
+  template<typename Allocator, typename Policy>
+  [[nodiscard]] typename BasicValue<Allocator, Policy>::String serializeToString(const BasicValue<Allocator, Policy> &v,
+                                                                                 const SerializationOptions &o = {},
+                                                                                 StringAllocation allocation = {},
+                                                                                 const Allocator &allocator = {}) {
+    return detail::serializeToString<typename BasicValue<Allocator, Policy>::String>(v, o, allocation, allocator);
+  }
+
+  // exact size of the serialized value
+  template<typename Allocator, typename Policy>
+  [[nodiscard]] size_t serializedSize(const BasicValue<Allocator, Policy> &v, const SerializationOptions &o = {}) {
+    return detail::serializedSize(v, o);
+  }
+
+  // writes as much of the serialized value as fits into [buffer, buffer + size),
+  // returns the size of the whole serialized value, i.e. the result is complete if it doesn't exceed size
+  template<typename Allocator, typename Policy>
+  size_t serializeToBuffer(char *buffer, size_t size, const BasicValue<Allocator, Policy> &v,
+                           const SerializationOptions &o = {}) {
+    return detail::serializeToBuffer(buffer, size, v, o);
+  }
+
+  inline void serializeToStream(std::ostream &s, const DocumentElement &e, const SerializationOptions &o = {}) {
+    impl::serialize(BufferedSink<StdOStreamSink>{ { s } }, e, o);
+  }
+  template<typename Allocator>
+  void serializeToStream(std::ostream &s, const BasicDocument<Allocator> &d, const SerializationOptions &o = {}) {
+    serializeToStream(s, d.root(), o);
+  }
+
+  template<typename String_t = String>
+  [[nodiscard]] String_t serializeToString(const DocumentElement &e,
+                                           const SerializationOptions &o = {},
+                                           StringAllocation allocation = {}) {
+    return detail::serializeToString<String_t>(e, o, allocation);
+  }
+  template<typename String_t = String, typename Allocator>
+  [[nodiscard]] String_t serializeToString(const BasicDocument<Allocator> &d,
+                                           const SerializationOptions &o = {},
+                                           StringAllocation allocation = {}) {
+    return serializeToString<String_t>(d.root(), o, allocation);
+  }
+
+  [[nodiscard]] inline size_t serializedSize(const DocumentElement &e, const SerializationOptions &o = {}) {
+    return detail::serializedSize(e, o);
+  }
   template<typename Allocator>
-  void serializeToStream(std::ostream &s, const BasicValue<Allocator> &v, const SerializationOptions &o = {}) {
-    impl::serialize(detail::StdOStreamSink{ s }, v, o);
+  [[nodiscard]] size_t serializedSize(const BasicDocument<Allocator> &d, const SerializationOptions &o = {}) {
+    return serializedSize(d.root(), o);
   }
 
+  inline size_t serializeToBuffer(char *buffer, size_t size, const DocumentElement &e, const SerializationOptions &o = {}) {
+    return detail::serializeToBuffer(buffer, size, e, o);
+  }
   template<typename Allocator>
-  [[nodiscard]] typename BasicValue<Allocator>::String serializeToString(const BasicValue<Allocator> &v,
-                                                                         const SerializationOptions &o = {}) {
-    typename BasicValue<Allocator>::String s;
-    impl::serialize(detail::StringSink<typename BasicValue<Allocator>::String>{ s }, v, o);
-    return s;
+  size_t serializeToBuffer(char *buffer, size_t size, const BasicDocument<Allocator> &d,
+                           const SerializationOptions &o = {}) {
+    return serializeToBuffer(buffer, size, d.root(), o);
   }
 
 
@@ -745,6 +2703,508 @@ namespace minjson {
       char buf[4];
     };
     inline bool isDecimalDigit(char c) { return '0' <= c && c <= '9'; }
+    // 8 characters loaded as little endian integer
+    inline bool areEightDecimalDigits(uint64_t chars) {
+      // high nibbles are 3, and adding 6 to low nibbles doesn't carry into high nibbles
+      return (chars & 0xF0F0F0F0F0F0F0F0) == 0x3030303030303030 &&
+        ((chars + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) == 0x3030303030303030;
+    }
+    inline uint32_t parseEightDecimalDigits(uint64_t chars) {
+      chars -= 0x3030303030303030;
+      chars = chars * 10 + (chars >> 8); // pairs of digits in even bytes
+      return static_cast<uint32_t>(((chars & 0x000000FF000000FF) * (100 + (1000000ull << 32)) +
+                                    ((chars >> 16) & 0x000000FF000000FF) * (1 + (10000ull << 32))) >> 32);
+    }
+    // accumulates decimal digits into value (which wraps around after 19 digits), returns the end of digits
+    inline const char *parseDecimalDigits(const char *p, const char *end, uint64_t &value) {
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+      for (uint64_t chars; end - p >= 8; p += 8) {
+        std::memcpy(&chars, p, sizeof(chars));
+        if (!areEightDecimalDigits(chars))
+          break;
+        value = value * 100000000 + parseEightDecimalDigits(chars);
+      }
+#endif
+      for (; p != end && isDecimalDigit(*p); ++p)
+        value = value * 10 + static_cast<uint64_t>(*p - '0');
+      return p;
+    }
+
+    struct UInt128 {
+      uint64_t low, high;
+    };
+    inline UInt128 multiplyFull(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+      __extension__ using Native = unsigned __int128;
+      const Native product = static_cast<Native>(a) * b;
+      return { static_cast<uint64_t>(product), static_cast<uint64_t>(product >> 64) };
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_X64)
+      UInt128 product;
+      product.low = _umul128(a, b, &product.high);
+      return product;
+#elif defined(_MSC_VER) && !defined(__clang__) && defined(_M_ARM64)
+      return { a * b, __umulh(a, b) };
+#else
+      const uint64_t aLow = a & 0xFFFFFFFF, aHigh = a >> 32, bLow = b & 0xFFFFFFFF, bHigh = b >> 32;
+      const uint64_t lowLow = aLow * bLow, highLow = aHigh * bLow, lowHigh = aLow * bHigh;
+      const uint64_t middle = (lowLow >> 32) + (highLow & 0xFFFFFFFF) + lowHigh;
+      return { (middle << 32) | (lowLow & 0xFFFFFFFF), aHigh * bHigh + (highLow >> 32) + (middle >> 32) };
+#endif
+    }
+
+    inline constexpr int64_t MinPowerOfFive = -342, MaxPowerOfFive = 324;
+    // 128 bit approximations of 5^q for q in [-342, 324] normalized so that the most significant bit is set,
+    // pairs of high and low 64 bit halves, generated the same way as in fast_float:
+    // for q >= 0 5^q truncated to 128 bits,
+    // for q in [-27, 0) floor(2^b / 5^-q) + 1 with b = ceil(log2(5^-q)) + 127, i.e. 2^b / 5^-q rounded up,
+    // for q < -27 floor(2^b / 5^-q) + 1 with b = 2 * ceil(log2(5^-q)) + 128 truncated to 128 bits
+    inline constexpr uint64_t PowersOfFive[2 * (MaxPowerOfFive - MinPowerOfFive + 1)] = {
+      0xeef453d6923bd65a, 0x113faa2906a13b3f, 0x9558b4661b6565f8, 0x4ac7ca59a424c507,
+      0xbaaee17fa23ebf76, 0x5d79bcf00d2df649, 0xe95a99df8ace6f53, 0xf4d82c2c107973dc,
+      0x91d8a02bb6c10594, 0x79071b9b8a4be869, 0xb64ec836a47146f9, 0x9748e2826cdee284,
+      0xe3e27a444d8d98b7, 0xfd1b1b2308169b25, 0x8e6d8c6ab0787f72, 0xfe30f0f5e50e20f7,
+      0xb208ef855c969f4f, 0xbdbd2d335e51a935, 0xde8b2b66b3bc4723, 0xad2c788035e61382,
+      0x8b16fb203055ac76, 0x4c3bcb5021afcc31, 0xaddcb9e83c6b1793, 0xdf4abe242a1bbf3d,
+      0xd953e8624b85dd78, 0xd71d6dad34a2af0d, 0x87d4713d6f33aa6b, 0x8672648c40e5ad68,
+      0xa9c98d8ccb009506, 0x680efdaf511f18c2, 0xd43bf0effdc0ba48, 0x0212bd1b2566def2,
+      0x84a57695fe98746d, 0x014bb630f7604b57, 0xa5ced43b7e3e9188, 0x419ea3bd35385e2d,
+      0xcf42894a5dce35ea, 0x52064cac828675b9, 0x818995ce7aa0e1b2, 0x7343efebd1940993,
+      0xa1ebfb4219491a1f, 0x1014ebe6c5f90bf8, 0xca66fa129f9b60a6, 0xd41a26e077774ef6,
+      0xfd00b897478238d0, 0x8920b098955522b4, 0x9e20735e8cb16382, 0x55b46e5f5d5535b0,
+      0xc5a890362fddbc62, 0xeb2189f734aa831d, 0xf712b443bbd52b7b, 0xa5e9ec7501d523e4,
+      0x9a6bb0aa55653b2d, 0x47b233c92125366e, 0xc1069cd4eabe89f8, 0x999ec0bb696e840a,
+      0xf148440a256e2c76, 0xc00670ea43ca250d, 0x96cd2a865764dbca, 0x380406926a5e5728,
+      0xbc807527ed3e12bc, 0xc605083704f5ecf2, 0xeba09271e88d976b, 0xf7864a44c633682e,
+      0x93445b8731587ea3, 0x7ab3ee6afbe0211d, 0xb8157268fdae9e4c, 0x5960ea05bad82964,
+      0xe61acf033d1a45df, 0x6fb92487298e33bd, 0x8fd0c16206306bab, 0xa5d3b6d479f8e056,
+      0xb3c4f1ba87bc8696, 0x8f48a4899877186c, 0xe0b62e2929aba83c, 0x331acdabfe94de87,
+      0x8c71dcd9ba0b4925, 0x9ff0c08b7f1d0b14, 0xaf8e5410288e1b6f, 0x07ecf0ae5ee44dd9,
+      0xdb71e91432b1a24a, 0xc9e82cd9f69d6150, 0x892731ac9faf056e, 0xbe311c083a225cd2,
+      0xab70fe17c79ac6ca, 0x6dbd630a48aaf406, 0xd64d3d9db981787d, 0x092cbbccdad5b108,
+      0x85f0468293f0eb4e, 0x25bbf56008c58ea5, 0xa76c582338ed2621, 0xaf2af2b80af6f24e,
+      0xd1476e2c07286faa, 0x1af5af660db4aee1, 0x82cca4db847945ca, 0x50d98d9fc890ed4d,
+      0xa37fce126597973c, 0xe50ff107bab528a0, 0xcc5fc196fefd7d0c, 0x1e53ed49a96272c8,
+      0xff77b1fcbebcdc4f, 0x25e8e89c13bb0f7a, 0x9faacf3df73609b1, 0x77b191618c54e9ac,
+      0xc795830d75038c1d, 0xd59df5b9ef6a2417, 0xf97ae3d0d2446f25, 0x4b0573286b44ad1d,
+      0x9becce62836ac577, 0x4ee367f9430aec32, 0xc2e801fb244576d5, 0x229c41f793cda73f,
+      0xf3a20279ed56d48a, 0x6b43527578c1110f, 0x9845418c345644d6, 0x830a13896b78aaa9,
+      0xbe5691ef416bd60c, 0x23cc986bc656d553, 0xedec366b11c6cb8f, 0x2cbfbe86b7ec8aa8,
+      0x94b3a202eb1c3f39, 0x7bf7d71432f3d6a9, 0xb9e08a83a5e34f07, 0xdaf5ccd93fb0cc53,
+      0xe858ad248f5c22c9, 0xd1b3400f8f9cff68, 0x91376c36d99995be, 0x23100809b9c21fa1,
+      0xb58547448ffffb2d, 0xabd40a0c2832a78a, 0xe2e69915b3fff9f9, 0x16c90c8f323f516c,
+      0x8dd01fad907ffc3b, 0xae3da7d97f6792e3, 0xb1442798f49ffb4a, 0x99cd11cfdf41779c,
+      0xdd95317f31c7fa1d, 0x40405643d711d583, 0x8a7d3eef7f1cfc52, 0x482835ea666b2572,
+      0xad1c8eab5ee43b66, 0xda3243650005eecf, 0xd863b256369d4a40, 0x90bed43e40076a82,
+      0x873e4f75e2224e68, 0x5a7744a6e804a291, 0xa90de3535aaae202, 0x711515d0a205cb36,
+      0xd3515c2831559a83, 0x0d5a5b44ca873e03, 0x8412d9991ed58091, 0xe858790afe9486c2,
+      0xa5178fff668ae0b6, 0x626e974dbe39a872, 0xce5d73ff402d98e3, 0xfb0a3d212dc8128f,
+      0x80fa687f881c7f8e, 0x7ce66634bc9d0b99, 0xa139029f6a239f72, 0x1c1fffc1ebc44e80,
+      0xc987434744ac874e, 0xa327ffb266b56220, 0xfbe9141915d7a922, 0x4bf1ff9f0062baa8,
+      0x9d71ac8fada6c9b5, 0x6f773fc3603db4a9, 0xc4ce17b399107c22, 0xcb550fb4384d21d3,
+      0xf6019da07f549b2b, 0x7e2a53a146606a48, 0x99c102844f94e0fb, 0x2eda7444cbfc426d,
+      0xc0314325637a1939, 0xfa911155fefb5308, 0xf03d93eebc589f88, 0x793555ab7eba27ca,
+      0x96267c7535b763b5, 0x4bc1558b2f3458de, 0xbbb01b9283253ca2, 0x9eb1aaedfb016f16,
+      0xea9c227723ee8bcb, 0x465e15a979c1cadc, 0x92a1958a7675175f, 0x0bfacd89ec191ec9,
+      0xb749faed14125d36, 0xcef980ec671f667b, 0xe51c79a85916f484, 0x82b7e12780e7401a,
+      0x8f31cc0937ae58d2, 0xd1b2ecb8b0908810, 0xb2fe3f0b8599ef07, 0x861fa7e6dcb4aa15,
+      0xdfbdcece67006ac9, 0x67a791e093e1d49a, 0x8bd6a141006042bd, 0xe0c8bb2c5c6d24e0,
+      0xaecc49914078536d, 0x58fae9f773886e18, 0xda7f5bf590966848, 0xaf39a475506a899e,
+      0x888f99797a5e012d, 0x6d8406c952429603, 0xaab37fd7d8f58178, 0xc8e5087ba6d33b83,
+      0xd5605fcdcf32e1d6, 0xfb1e4a9a90880a64, 0x855c3be0a17fcd26, 0x5cf2eea09a55067f,
+      0xa6b34ad8c9dfc06f, 0xf42faa48c0ea481e, 0xd0601d8efc57b08b, 0xf13b94daf124da26,
+      0x823c12795db6ce57, 0x76c53d08d6b70858, 0xa2cb1717b52481ed, 0x54768c4b0c64ca6e,
+      0xcb7ddcdda26da268, 0xa9942f5dcf7dfd09, 0xfe5d54150b090b02, 0xd3f93b35435d7c4c,
+      0x9efa548d26e5a6e1, 0xc47bc5014a1a6daf, 0xc6b8e9b0709f109a, 0x359ab6419ca1091b,
+      0xf867241c8cc6d4c0, 0xc30163d203c94b62, 0x9b407691d7fc44f8, 0x79e0de63425dcf1d,
+      0xc21094364dfb5636, 0x985915fc12f542e4, 0xf294b943e17a2bc4, 0x3e6f5b7b17b2939d,
+      0x979cf3ca6cec5b5a, 0xa705992ceecf9c42, 0xbd8430bd08277231, 0x50c6ff782a838353,
+      0xece53cec4a314ebd, 0xa4f8bf5635246428, 0x940f4613ae5ed136, 0x871b7795e136be99,
+      0xb913179899f68584, 0x28e2557b59846e3f, 0xe757dd7ec07426e5, 0x331aeada2fe589cf,
+      0x9096ea6f3848984f, 0x3ff0d2c85def7621, 0xb4bca50b065abe63, 0x0fed077a756b53a9,
+      0xe1ebce4dc7f16dfb, 0xd3e8495912c62894, 0x8d3360f09cf6e4bd, 0x64712dd7abbbd95c,
+      0xb080392cc4349dec, 0xbd8d794d96aacfb3, 0xdca04777f541c567, 0xecf0d7a0fc5583a0,
+      0x89e42caaf9491b60, 0xf41686c49db57244, 0xac5d37d5b79b6239, 0x311c2875c522ced5,
+      0xd77485cb25823ac7, 0x7d633293366b828b, 0x86a8d39ef77164bc, 0xae5dff9c02033197,
+      0xa8530886b54dbdeb, 0xd9f57f830283fdfc, 0xd267caa862a12d66, 0xd072df63c324fd7b,
+      0x8380dea93da4bc60, 0x4247cb9e59f71e6d, 0xa46116538d0deb78, 0x52d9be85f074e608,
+      0xcd795be870516656, 0x67902e276c921f8b, 0x806bd9714632dff6, 0x00ba1cd8a3db53b6,
+      0xa086cfcd97bf97f3, 0x80e8a40eccd228a4, 0xc8a883c0fdaf7df0, 0x6122cd128006b2cd,
+      0xfad2a4b13d1b5d6c, 0x796b805720085f81, 0x9cc3a6eec6311a63, 0xcbe3303674053bb0,
+      0xc3f490aa77bd60fc, 0xbedbfc4411068a9c, 0xf4f1b4d515acb93b, 0xee92fb5515482d44,
+      0x991711052d8bf3c5, 0x751bdd152d4d1c4a, 0xbf5cd54678eef0b6, 0xd262d45a78a0635d,
+      0xef340a98172aace4, 0x86fb897116c87c34, 0x9580869f0e7aac0e, 0xd45d35e6ae3d4da0,
+      0xbae0a846d2195712, 0x8974836059cca109, 0xe998d258869facd7, 0x2bd1a438703fc94b,
+      0x91ff83775423cc06, 0x7b6306a34627ddcf, 0xb67f6455292cbf08, 0x1a3bc84c17b1d542,
+      0xe41f3d6a7377eeca, 0x20caba5f1d9e4a93, 0x8e938662882af53e, 0x547eb47b7282ee9c,
+      0xb23867fb2a35b28d, 0xe99e619a4f23aa43, 0xdec681f9f4c31f31, 0x6405fa00e2ec94d4,
+      0x8b3c113c38f9f37e, 0xde83bc408dd3dd04, 0xae0b158b4738705e, 0x9624ab50b148d445,
+      0xd98ddaee19068c76, 0x3badd624dd9b0957, 0x87f8a8d4cfa417c9, 0xe54ca5d70a80e5d6,
+      0xa9f6d30a038d1dbc, 0x5e9fcf4ccd211f4c, 0xd47487cc8470652b, 0x7647c3200069671f,
+      0x84c8d4dfd2c63f3b, 0x29ecd9f40041e073, 0xa5fb0a17c777cf09, 0xf468107100525890,
+      0xcf79cc9db955c2cc, 0x7182148d4066eeb4, 0x81ac1fe293d599bf, 0xc6f14cd848405530,
+      0xa21727db38cb002f, 0xb8ada00e5a506a7c, 0xca9cf1d206fdc03b, 0xa6d90811f0e4851c,
+      0xfd442e4688bd304a, 0x908f4a166d1da663, 0x9e4a9cec15763e2e, 0x9a598e4e043287fe,
+      0xc5dd44271ad3cdba, 0x40eff1e1853f29fd, 0xf7549530e188c128, 0xd12bee59e68ef47c,
+      0x9a94dd3e8cf578b9, 0x82bb74f8301958ce, 0xc13a148e3032d6e7, 0xe36a52363c1faf01,
+      0xf18899b1bc3f8ca1, 0xdc44e6c3cb279ac1, 0x96f5600f15a7b7e5, 0x29ab103a5ef8c0b9,
+      0xbcb2b812db11a5de, 0x7415d448f6b6f0e7, 0xebdf661791d60f56, 0x111b495b3464ad21,
+      0x936b9fcebb25c995, 0xcab10dd900beec34, 0xb84687c269ef3bfb, 0x3d5d514f40eea742,
+      0xe65829b3046b0afa, 0x0cb4a5a3112a5112, 0x8ff71a0fe2c2e6dc, 0x47f0e785eaba72ab,
+      0xb3f4e093db73a093, 0x59ed216765690f56, 0xe0f218b8d25088b8, 0x306869c13ec3532c,
+      0x8c974f7383725573, 0x1e414218c73a13fb, 0xafbd2350644eeacf, 0xe5d1929ef90898fa,
+      0xdbac6c247d62a583, 0xdf45f746b74abf39, 0x894bc396ce5da772, 0x6b8bba8c328eb783,
+      0xab9eb47c81f5114f, 0x066ea92f3f326564, 0xd686619ba27255a2, 0xc80a537b0efefebd,
+      0x8613fd0145877585, 0xbd06742ce95f5f36, 0xa798fc4196e952e7, 0x2c48113823b73704,
+      0xd17f3b51fca3a7a0, 0xf75a15862ca504c5, 0x82ef85133de648c4, 0x9a984d73dbe722fb,
+      0xa3ab66580d5fdaf5, 0xc13e60d0d2e0ebba, 0xcc963fee10b7d1b3, 0x318df905079926a8,
+      0xffbbcfe994e5c61f, 0xfdf17746497f7052, 0x9fd561f1fd0f9bd3, 0xfeb6ea8bedefa633,
+      0xc7caba6e7c5382c8, 0xfe64a52ee96b8fc0, 0xf9bd690a1b68637b, 0x3dfdce7aa3c673b0,
+      0x9c1661a651213e2d, 0x06bea10ca65c084e, 0xc31bfa0fe5698db8, 0x486e494fcff30a62,
+      0xf3e2f893dec3f126, 0x5a89dba3c3efccfa, 0x986ddb5c6b3a76b7, 0xf89629465a75e01c,
+      0xbe89523386091465, 0xf6bbb397f1135823, 0xee2ba6c0678b597f, 0x746aa07ded582e2c,
+      0x94db483840b717ef, 0xa8c2a44eb4571cdc, 0xba121a4650e4ddeb, 0x92f34d62616ce413,
+      0xe896a0d7e51e1566, 0x77b020baf9c81d17, 0x915e2486ef32cd60, 0x0ace1474dc1d122e,
+      0xb5b5ada8aaff80b8, 0x0d819992132456ba, 0xe3231912d5bf60e6, 0x10e1fff697ed6c69,
+      0x8df5efabc5979c8f, 0xca8d3ffa1ef463c1, 0xb1736b96b6fd83b3, 0xbd308ff8a6b17cb2,
+      0xddd0467c64bce4a0, 0xac7cb3f6d05ddbde, 0x8aa22c0dbef60ee4, 0x6bcdf07a423aa96b,
+      0xad4ab7112eb3929d, 0x86c16c98d2c953c6, 0xd89d64d57a607744, 0xe871c7bf077ba8b7,
+      0x87625f056c7c4a8b, 0x11471cd764ad4972, 0xa93af6c6c79b5d2d, 0xd598e40d3dd89bcf,
+      0xd389b47879823479, 0x4aff1d108d4ec2c3, 0x843610cb4bf160cb, 0xcedf722a585139ba,
+      0xa54394fe1eedb8fe, 0xc2974eb4ee658828, 0xce947a3da6a9273e, 0x733d226229feea32,
+      0x811ccc668829b887, 0x0806357d5a3f525f, 0xa163ff802a3426a8, 0xca07c2dcb0cf26f7,
+      0xc9bcff6034c13052, 0xfc89b393dd02f0b5, 0xfc2c3f3841f17c67, 0xbbac2078d443ace2,
+      0x9d9ba7832936edc0, 0xd54b944b84aa4c0d, 0xc5029163f384a931, 0x0a9e795e65d4df11,
+      0xf64335bcf065d37d, 0x4d4617b5ff4a16d5, 0x99ea0196163fa42e, 0x504bced1bf8e4e45,
+      0xc06481fb9bcf8d39, 0xe45ec2862f71e1d6, 0xf07da27a82c37088, 0x5d767327bb4e5a4c,
+      0x964e858c91ba2655, 0x3a6a07f8d510f86f, 0xbbe226efb628afea, 0x890489f70a55368b,
+      0xeadab0aba3b2dbe5, 0x2b45ac74ccea842e, 0x92c8ae6b464fc96f, 0x3b0b8bc90012929d,
+      0xb77ada0617e3bbcb, 0x09ce6ebb40173744, 0xe55990879ddcaabd, 0xcc420a6a101d0515,
+      0x8f57fa54c2a9eab6, 0x9fa946824a12232d, 0xb32df8e9f3546564, 0x47939822dc96abf9,
+      0xdff9772470297ebd, 0x59787e2b93bc56f7, 0x8bfbea76c619ef36, 0x57eb4edb3c55b65a,
+      0xaefae51477a06b03, 0xede622920b6b23f1, 0xdab99e59958885c4, 0xe95fab368e45eced,
+      0x88b402f7fd75539b, 0x11dbcb0218ebb414, 0xaae103b5fcd2a881, 0xd652bdc29f26a119,
+      0xd59944a37c0752a2, 0x4be76d3346f0495f, 0x857fcae62d8493a5, 0x6f70a4400c562ddb,
+      0xa6dfbd9fb8e5b88e, 0xcb4ccd500f6bb952, 0xd097ad07a71f26b2, 0x7e2000a41346a7a7,
+      0x825ecc24c873782f, 0x8ed400668c0c28c8, 0xa2f67f2dfa90563b, 0x728900802f0f32fa,
+      0xcbb41ef979346bca, 0x4f2b40a03ad2ffb9, 0xfea126b7d78186bc, 0xe2f610c84987bfa8,
+      0x9f24b832e6b0f436, 0x0dd9ca7d2df4d7c9, 0xc6ede63fa05d3143, 0x91503d1c79720dbb,
+      0xf8a95fcf88747d94, 0x75a44c6397ce912a, 0x9b69dbe1b548ce7c, 0xc986afbe3ee11aba,
+      0xc24452da229b021b, 0xfbe85badce996168, 0xf2d56790ab41c2a2, 0xfae27299423fb9c3,
+      0x97c560ba6b0919a5, 0xdccd879fc967d41a, 0xbdb6b8e905cb600f, 0x5400e987bbc1c920,
+      0xed246723473e3813, 0x290123e9aab23b68, 0x9436c0760c86e30b, 0xf9a0b6720aaf6521,
+      0xb94470938fa89bce, 0xf808e40e8d5b3e69, 0xe7958cb87392c2c2, 0xb60b1d1230b20e04,
+      0x90bd77f3483bb9b9, 0xb1c6f22b5e6f48c2, 0xb4ecd5f01a4aa828, 0x1e38aeb6360b1af3,
+      0xe2280b6c20dd5232, 0x25c6da63c38de1b0, 0x8d590723948a535f, 0x579c487e5a38ad0e,
+      0xb0af48ec79ace837, 0x2d835a9df0c6d851, 0xdcdb1b2798182244, 0xf8e431456cf88e65,
+      0x8a08f0f8bf0f156b, 0x1b8e9ecb641b58ff, 0xac8b2d36eed2dac5, 0xe272467e3d222f3f,
+      0xd7adf884aa879177, 0x5b0ed81dcc6abb0f, 0x86ccbb52ea94baea, 0x98e947129fc2b4e9,
+      0xa87fea27a539e9a5, 0x3f2398d747b36224, 0xd29fe4b18e88640e, 0x8eec7f0d19a03aad,
+      0x83a3eeeef9153e89, 0x1953cf68300424ac, 0xa48ceaaab75a8e2b, 0x5fa8c3423c052dd7,
+      0xcdb02555653131b6, 0x3792f412cb06794d, 0x808e17555f3ebf11, 0xe2bbd88bbee40bd0,
+      0xa0b19d2ab70e6ed6, 0x5b6aceaeae9d0ec4, 0xc8de047564d20a8b, 0xf245825a5a445275,
+      0xfb158592be068d2e, 0xeed6e2f0f0d56712, 0x9ced737bb6c4183d, 0x55464dd69685606b,
+      0xc428d05aa4751e4c, 0xaa97e14c3c26b886, 0xf53304714d9265df, 0xd53dd99f4b3066a8,
+      0x993fe2c6d07b7fab, 0xe546a8038efe4029, 0xbf8fdb78849a5f96, 0xde98520472bdd033,
+      0xef73d256a5c0f77c, 0x963e66858f6d4440, 0x95a8637627989aad, 0xdde7001379a44aa8,
+      0xbb127c53b17ec159, 0x5560c018580d5d52, 0xe9d71b689dde71af, 0xaab8f01e6e10b4a6,
+      0x9226712162ab070d, 0xcab3961304ca70e8, 0xb6b00d69bb55c8d1, 0x3d607b97c5fd0d22,
+      0xe45c10c42a2b3b05, 0x8cb89a7db77c506a, 0x8eb98a7a9a5b04e3, 0x77f3608e92adb242,
+      0xb267ed1940f1c61c, 0x55f038b237591ed3, 0xdf01e85f912e37a3, 0x6b6c46dec52f6688,
+      0x8b61313bbabce2c6, 0x2323ac4b3b3da015, 0xae397d8aa96c1b77, 0xabec975e0a0d081a,
+      0xd9c7dced53c72255, 0x96e7bd358c904a21, 0x881cea14545c7575, 0x7e50d64177da2e54,
+      0xaa242499697392d2, 0xdde50bd1d5d0b9e9, 0xd4ad2dbfc3d07787, 0x955e4ec64b44e864,
+      0x84ec3c97da624ab4, 0xbd5af13bef0b113e, 0xa6274bbdd0fadd61, 0xecb1ad8aeacdd58e,
+      0xcfb11ead453994ba, 0x67de18eda5814af2, 0x81ceb32c4b43fcf4, 0x80eacf948770ced7,
+      0xa2425ff75e14fc31, 0xa1258379a94d028d, 0xcad2f7f5359a3b3e, 0x096ee45813a04330,
+      0xfd87b5f28300ca0d, 0x8bca9d6e188853fc, 0x9e74d1b791e07e48, 0x775ea264cf55347e,
+      0xc612062576589dda, 0x95364afe032a819e, 0xf79687aed3eec551, 0x3a83ddbd83f52205,
+      0x9abe14cd44753b52, 0xc4926a9672793543, 0xc16d9a0095928a27, 0x75b7053c0f178294,
+      0xf1c90080baf72cb1, 0x5324c68b12dd6339, 0x971da05074da7bee, 0xd3f6fc16ebca5e04,
+      0xbce5086492111aea, 0x88f4bb1ca6bcf585, 0xec1e4a7db69561a5, 0x2b31e9e3d06c32e6,
+      0x9392ee8e921d5d07, 0x3aff322e62439fd0, 0xb877aa3236a4b449, 0x09befeb9fad487c3,
+      0xe69594bec44de15b, 0x4c2ebe687989a9b4, 0x901d7cf73ab0acd9, 0x0f9d37014bf60a11,
+      0xb424dc35095cd80f, 0x538484c19ef38c95, 0xe12e13424bb40e13, 0x2865a5f206b06fba,
+      0x8cbccc096f5088cb, 0xf93f87b7442e45d4, 0xafebff0bcb24aafe, 0xf78f69a51539d749,
+      0xdbe6fecebdedd5be, 0xb573440e5a884d1c, 0x89705f4136b4a597, 0x31680a88f8953031,
+      0xabcc77118461cefc, 0xfdc20d2b36ba7c3e, 0xd6bf94d5e57a42bc, 0x3d32907604691b4d,
+      0x8637bd05af6c69b5, 0xa63f9a49c2c1b110, 0xa7c5ac471b478423, 0x0fcf80dc33721d54,
+      0xd1b71758e219652b, 0xd3c36113404ea4a9, 0x83126e978d4fdf3b, 0x645a1cac083126ea,
+      0xa3d70a3d70a3d70a, 0x3d70a3d70a3d70a4, 0xcccccccccccccccc, 0xcccccccccccccccd,
+      0x8000000000000000, 0x0000000000000000, 0xa000000000000000, 0x0000000000000000,
+      0xc800000000000000, 0x0000000000000000, 0xfa00000000000000, 0x0000000000000000,
+      0x9c40000000000000, 0x0000000000000000, 0xc350000000000000, 0x0000000000000000,
+      0xf424000000000000, 0x0000000000000000, 0x9896800000000000, 0x0000000000000000,
+      0xbebc200000000000, 0x0000000000000000, 0xee6b280000000000, 0x0000000000000000,
+      0x9502f90000000000, 0x0000000000000000, 0xba43b74000000000, 0x0000000000000000,
+      0xe8d4a51000000000, 0x0000000000000000, 0x9184e72a00000000, 0x0000000000000000,
+      0xb5e620f480000000, 0x0000000000000000, 0xe35fa931a0000000, 0x0000000000000000,
+      0x8e1bc9bf04000000, 0x0000000000000000, 0xb1a2bc2ec5000000, 0x0000000000000000,
+      0xde0b6b3a76400000, 0x0000000000000000, 0x8ac7230489e80000, 0x0000000000000000,
+      0xad78ebc5ac620000, 0x0000000000000000, 0xd8d726b7177a8000, 0x0000000000000000,
+      0x878678326eac9000, 0x0000000000000000, 0xa968163f0a57b400, 0x0000000000000000,
+      0xd3c21bcecceda100, 0x0000000000000000, 0x84595161401484a0, 0x0000000000000000,
+      0xa56fa5b99019a5c8, 0x0000000000000000, 0xcecb8f27f4200f3a, 0x0000000000000000,
+      0x813f3978f8940984, 0x4000000000000000, 0xa18f07d736b90be5, 0x5000000000000000,
+      0xc9f2c9cd04674ede, 0xa400000000000000, 0xfc6f7c4045812296, 0x4d00000000000000,
+      0x9dc5ada82b70b59d, 0xf020000000000000, 0xc5371912364ce305, 0x6c28000000000000,
+      0xf684df56c3e01bc6, 0xc732000000000000, 0x9a130b963a6c115c, 0x3c7f400000000000,
+      0xc097ce7bc90715b3, 0x4b9f100000000000, 0xf0bdc21abb48db20, 0x1e86d40000000000,
+      0x96769950b50d88f4, 0x1314448000000000, 0xbc143fa4e250eb31, 0x17d955a000000000,
+      0xeb194f8e1ae525fd, 0x5dcfab0800000000, 0x92efd1b8d0cf37be, 0x5aa1cae500000000,
+      0xb7abc627050305ad, 0xf14a3d9e40000000, 0xe596b7b0c643c719, 0x6d9ccd05d0000000,
+      0x8f7e32ce7bea5c6f, 0xe4820023a2000000, 0xb35dbf821ae4f38b, 0xdda2802c8a800000,
+      0xe0352f62a19e306e, 0xd50b2037ad200000, 0x8c213d9da502de45, 0x4526f422cc340000,
+      0xaf298d050e4395d6, 0x9670b12b7f410000, 0xdaf3f04651d47b4c, 0x3c0cdd765f114000,
+      0x88d8762bf324cd0f, 0xa5880a69fb6ac800, 0xab0e93b6efee0053, 0x8eea0d047a457a00,
+      0xd5d238a4abe98068, 0x72a4904598d6d880, 0x85a36366eb71f041, 0x47a6da2b7f864750,
+      0xa70c3c40a64e6c51, 0x999090b65f67d924, 0xd0cf4b50cfe20765, 0xfff4b4e3f741cf6d,
+      0x82818f1281ed449f, 0xbff8f10e7a8921a4, 0xa321f2d7226895c7, 0xaff72d52192b6a0d,
+      0xcbea6f8ceb02bb39, 0x9bf4f8a69f764490, 0xfee50b7025c36a08, 0x02f236d04753d5b4,
+      0x9f4f2726179a2245, 0x01d762422c946590, 0xc722f0ef9d80aad6, 0x424d3ad2b7b97ef5,
+      0xf8ebad2b84e0d58b, 0xd2e0898765a7deb2, 0x9b934c3b330c8577, 0x63cc55f49f88eb2f,
+      0xc2781f49ffcfa6d5, 0x3cbf6b71c76b25fb, 0xf316271c7fc3908a, 0x8bef464e3945ef7a,
+      0x97edd871cfda3a56, 0x97758bf0e3cbb5ac, 0xbde94e8e43d0c8ec, 0x3d52eeed1cbea317,
+      0xed63a231d4c4fb27, 0x4ca7aaa863ee4bdd, 0x945e455f24fb1cf8, 0x8fe8caa93e74ef6a,
+      0xb975d6b6ee39e436, 0xb3e2fd538e122b44, 0xe7d34c64a9c85d44, 0x60dbbca87196b616,
+      0x90e40fbeea1d3a4a, 0xbc8955e946fe31cd, 0xb51d13aea4a488dd, 0x6babab6398bdbe41,
+      0xe264589a4dcdab14, 0xc696963c7eed2dd1, 0x8d7eb76070a08aec, 0xfc1e1de5cf543ca2,
+      0xb0de65388cc8ada8, 0x3b25a55f43294bcb, 0xdd15fe86affad912, 0x49ef0eb713f39ebe,
+      0x8a2dbf142dfcc7ab, 0x6e3569326c784337, 0xacb92ed9397bf996, 0x49c2c37f07965404,
+      0xd7e77a8f87daf7fb, 0xdc33745ec97be906, 0x86f0ac99b4e8dafd, 0x69a028bb3ded71a3,
+      0xa8acd7c0222311bc, 0xc40832ea0d68ce0c, 0xd2d80db02aabd62b, 0xf50a3fa490c30190,
+      0x83c7088e1aab65db, 0x792667c6da79e0fa, 0xa4b8cab1a1563f52, 0x577001b891185938,
+      0xcde6fd5e09abcf26, 0xed4c0226b55e6f86, 0x80b05e5ac60b6178, 0x544f8158315b05b4,
+      0xa0dc75f1778e39d6, 0x696361ae3db1c721, 0xc913936dd571c84c, 0x03bc3a19cd1e38e9,
+      0xfb5878494ace3a5f, 0x04ab48a04065c723, 0x9d174b2dcec0e47b, 0x62eb0d64283f9c76,
+      0xc45d1df942711d9a, 0x3ba5d0bd324f8394, 0xf5746577930d6500, 0xca8f44ec7ee36479,
+      0x9968bf6abbe85f20, 0x7e998b13cf4e1ecb, 0xbfc2ef456ae276e8, 0x9e3fedd8c321a67e,
+      0xefb3ab16c59b14a2, 0xc5cfe94ef3ea101e, 0x95d04aee3b80ece5, 0xbba1f1d158724a12,
+      0xbb445da9ca61281f, 0x2a8a6e45ae8edc97, 0xea1575143cf97226, 0xf52d09d71a3293bd,
+      0x924d692ca61be758, 0x593c2626705f9c56, 0xb6e0c377cfa2e12e, 0x6f8b2fb00c77836c,
+      0xe498f455c38b997a, 0x0b6dfb9c0f956447, 0x8edf98b59a373fec, 0x4724bd4189bd5eac,
+      0xb2977ee300c50fe7, 0x58edec91ec2cb657, 0xdf3d5e9bc0f653e1, 0x2f2967b66737e3ed,
+      0x8b865b215899f46c, 0xbd79e0d20082ee74, 0xae67f1e9aec07187, 0xecd8590680a3aa11,
+      0xda01ee641a708de9, 0xe80e6f4820cc9495, 0x884134fe908658b2, 0x3109058d147fdcdd,
+      0xaa51823e34a7eede, 0xbd4b46f0599fd415, 0xd4e5e2cdc1d1ea96, 0x6c9e18ac7007c91a,
+      0x850fadc09923329e, 0x03e2cf6bc604ddb0, 0xa6539930bf6bff45, 0x84db8346b786151c,
+      0xcfe87f7cef46ff16, 0xe612641865679a63, 0x81f14fae158c5f6e, 0x4fcb7e8f3f60c07e,
+      0xa26da3999aef7749, 0xe3be5e330f38f09d, 0xcb090c8001ab551c, 0x5cadf5bfd3072cc5,
+      0xfdcb4fa002162a63, 0x73d9732fc7c8f7f6, 0x9e9f11c4014dda7e, 0x2867e7fddcdd9afa,
+      0xc646d63501a1511d, 0xb281e1fd541501b8, 0xf7d88bc24209a565, 0x1f225a7ca91a4226,
+      0x9ae757596946075f, 0x3375788de9b06958, 0xc1a12d2fc3978937, 0x0052d6b1641c83ae,
+      0xf209787bb47d6b84, 0xc0678c5dbd23a49a, 0x9745eb4d50ce6332, 0xf840b7ba963646e0,
+      0xbd176620a501fbff, 0xb650e5a93bc3d898, 0xec5d3fa8ce427aff, 0xa3e51f138ab4cebe,
+      0x93ba47c980e98cdf, 0xc66f336c36b10137, 0xb8a8d9bbe123f017, 0xb80b0047445d4184,
+      0xe6d3102ad96cec1d, 0xa60dc059157491e5, 0x9043ea1ac7e41392, 0x87c89837ad68db2f,
+      0xb454e4a179dd1877, 0x29babe4598c311fb, 0xe16a1dc9d8545e94, 0xf4296dd6fef3d67a,
+      0x8ce2529e2734bb1d, 0x1899e4a65f58660c, 0xb01ae745b101e9e4, 0x5ec05dcff72e7f8f,
+      0xdc21a1171d42645d, 0x76707543f4fa1f73, 0x899504ae72497eba, 0x6a06494a791c53a8,
+      0xabfa45da0edbde69, 0x0487db9d17636892, 0xd6f8d7509292d603, 0x45a9d2845d3c42b6,
+      0x865b86925b9bc5c2, 0x0b8a2392ba45a9b2, 0xa7f26836f282b732, 0x8e6cac7768d7141e,
+      0xd1ef0244af2364ff, 0x3207d795430cd926, 0x8335616aed761f1f, 0x7f44e6bd49e807b8,
+      0xa402b9c5a8d3a6e7, 0x5f16206c9c6209a6, 0xcd036837130890a1, 0x36dba887c37a8c0f,
+      0x802221226be55a64, 0xc2494954da2c9789, 0xa02aa96b06deb0fd, 0xf2db9baa10b7bd6c,
+      0xc83553c5c8965d3d, 0x6f92829494e5acc7, 0xfa42a8b73abbf48c, 0xcb772339ba1f17f9,
+      0x9c69a97284b578d7, 0xff2a760414536efb, 0xc38413cf25e2d70d, 0xfef5138519684aba,
+      0xf46518c2ef5b8cd1, 0x7eb258665fc25d69, 0x98bf2f79d5993802, 0xef2f773ffbd97a61,
+      0xbeeefb584aff8603, 0xaafb550ffacfd8fa, 0xeeaaba2e5dbf6784, 0x95ba2a53f983cf38,
+      0x952ab45cfa97a0b2, 0xdd945a747bf26183, 0xba756174393d88df, 0x94f971119aeef9e4,
+      0xe912b9d1478ceb17, 0x7a37cd5601aab85d, 0x91abb422ccb812ee, 0xac62e055c10ab33a,
+      0xb616a12b7fe617aa, 0x577b986b314d6009, 0xe39c49765fdf9d94, 0xed5a7e85fda0b80b,
+      0x8e41ade9fbebc27d, 0x14588f13be847307, 0xb1d219647ae6b31c, 0x596eb2d8ae258fc8,
+      0xde469fbd99a05fe3, 0x6fca5f8ed9aef3bb, 0x8aec23d680043bee, 0x25de7bb9480d5854,
+      0xada72ccc20054ae9, 0xaf561aa79a10ae6a, 0xd910f7ff28069da4, 0x1b2ba1518094da04,
+      0x87aa9aff79042286, 0x90fb44d2f05d0842, 0xa99541bf57452b28, 0x353a1607ac744a53,
+      0xd3fa922f2d1675f2, 0x42889b8997915ce8, 0x847c9b5d7c2e09b7, 0x69956135febada11,
+      0xa59bc234db398c25, 0x43fab9837e699095, 0xcf02b2c21207ef2e, 0x94f967e45e03f4bb,
+      0x8161afb94b44f57d, 0x1d1be0eebac278f5, 0xa1ba1ba79e1632dc, 0x6462d92a69731732,
+      0xca28a291859bbf93, 0x7d7b8f7503cfdcfe, 0xfcb2cb35e702af78, 0x5cda735244c3d43e,
+      0x9defbf01b061adab, 0x3a0888136afa64a7, 0xc56baec21c7a1916, 0x088aaa1845b8fdd0,
+      0xf6c69a72a3989f5b, 0x8aad549e57273d45, 0x9a3c2087a63f6399, 0x36ac54e2f678864b,
+      0xc0cb28a98fcf3c7f, 0x84576a1bb416a7dd, 0xf0fdf2d3f3c30b9f, 0x656d44a2a11c51d5,
+      0x969eb7c47859e743, 0x9f644ae5a4b1b325, 0xbc4665b596706114, 0x873d5d9f0dde1fee,
+      0xeb57ff22fc0c7959, 0xa90cb506d155a7ea, 0x9316ff75dd87cbd8, 0x09a7f12442d588f2,
+      0xb7dcbf5354e9bece, 0x0c11ed6d538aeb2f, 0xe5d3ef282a242e81, 0x8f1668c8a86da5fa,
+      0x8fa475791a569d10, 0xf96e017d694487bc, 0xb38d92d760ec4455, 0x37c981dcc395a9ac,
+      0xe070f78d3927556a, 0x85bbe253f47b1417, 0x8c469ab843b89562, 0x93956d7478ccec8e,
+      0xaf58416654a6babb, 0x387ac8d1970027b2, 0xdb2e51bfe9d0696a, 0x06997b05fcc0319e,
+      0x88fcf317f22241e2, 0x441fece3bdf81f03, 0xab3c2fddeeaad25a, 0xd527e81cad7626c3,
+      0xd60b3bd56a5586f1, 0x8a71e223d8d3b074, 0x85c7056562757456, 0xf6872d5667844e49,
+      0xa738c6bebb12d16c, 0xb428f8ac016561db, 0xd106f86e69d785c7, 0xe13336d701beba52,
+      0x82a45b450226b39c, 0xecc0024661173473, 0xa34d721642b06084, 0x27f002d7f95d0190,
+      0xcc20ce9bd35c78a5, 0x31ec038df7b441f4, 0xff290242c83396ce, 0x7e67047175a15271,
+      0x9f79a169bd203e41, 0x0f0062c6e984d386, 0xc75809c42c684dd1, 0x52c07b78a3e60868,
+      0xf92e0c3537826145, 0xa7709a56ccdf8a82, 0x9bbcc7a142b17ccb, 0x88a66076400bb691,
+      0xc2abf989935ddbfe, 0x6acff893d00ea435, 0xf356f7ebf83552fe, 0x0583f6b8c4124d43,
+      0x98165af37b2153de, 0xc3727a337a8b704a, 0xbe1bf1b059e9a8d6, 0x744f18c0592e4c5c,
+      0xeda2ee1c7064130c, 0x1162def06f79df73, 0x9485d4d1c63e8be7, 0x8addcb5645ac2ba8,
+      0xb9a74a0637ce2ee1, 0x6d953e2bd7173692, 0xe8111c87c5c1ba99, 0xc8fa8db6ccdd0437,
+      0x910ab1d4db9914a0, 0x1d9c9892400a22a2, 0xb54d5e4a127f59c8, 0x2503beb6d00cab4b,
+      0xe2a0b5dc971f303a, 0x2e44ae64840fd61d, 0x8da471a9de737e24, 0x5ceaecfed289e5d2,
+      0xb10d8e1456105dad, 0x7425a83e872c5f47, 0xdd50f1996b947518, 0xd12f124e28f77719,
+      0x8a5296ffe33cc92f, 0x82bd6b70d99aaa6f, 0xace73cbfdc0bfb7b, 0x636cc64d1001550b,
+      0xd8210befd30efa5a, 0x3c47f7e05401aa4e, 0x8714a775e3e95c78, 0x65acfaec34810a71,
+      0xa8d9d1535ce3b396, 0x7f1839a741a14d0d, 0xd31045a8341ca07c, 0x1ede48111209a050,
+      0x83ea2b892091e44d, 0x934aed0aab460432, 0xa4e4b66b68b65d60, 0xf81da84d5617853f,
+      0xce1de40642e3f4b9, 0x36251260ab9d668e, 0x80d2ae83e9ce78f3, 0xc1d72b7c6b426019,
+      0xa1075a24e4421730, 0xb24cf65b8612f81f, 0xc94930ae1d529cfc, 0xdee033f26797b627,
+      0xfb9b7cd9a4a7443c, 0x169840ef017da3b1, 0x9d412e0806e88aa5, 0x8e1f289560ee864e,
+      0xc491798a08a2ad4e, 0xf1a6f2bab92a27e2, 0xf5b5d7ec8acb58a2, 0xae10af696774b1db,
+      0x9991a6f3d6bf1765, 0xacca6da1e0a8ef29, 0xbff610b0cc6edd3f, 0x17fd090a58d32af3,
+      0xeff394dcff8a948e, 0xddfc4b4cef07f5b0, 0x95f83d0a1fb69cd9, 0x4abdaf101564f98e,
+      0xbb764c4ca7a4440f, 0x9d6d1ad41abe37f1, 0xea53df5fd18d5513, 0x84c86189216dc5ed,
+      0x92746b9be2f8552c, 0x32fd3cf5b4e49bb4, 0xb7118682dbb66a77, 0x3fbc8c33221dc2a1,
+      0xe4d5e82392a40515, 0x0fabaf3feaa5334a, 0x8f05b1163ba6832d, 0x29cb4d87f2a7400e,
+      0xb2c71d5bca9023f8, 0x743e20e9ef511012, 0xdf78e4b2bd342cf6, 0x914da9246b255416,
+      0x8bab8eefb6409c1a, 0x1ad089b6c2f7548e, 0xae9672aba3d0c320, 0xa184ac2473b529b1,
+      0xda3c0f568cc4f3e8, 0xc9e5d72d90a2741e, 0x8865899617fb1871, 0x7e2fa67c7a658892,
+      0xaa7eebfb9df9de8d, 0xddbb901b98feeab7, 0xd51ea6fa85785631, 0x552a74227f3ea565,
+      0x8533285c936b35de, 0xd53a88958f87275f, 0xa67ff273b8460356, 0x8a892abaf368f137,
+      0xd01fef10a657842c, 0x2d2b7569b0432d85, 0x8213f56a67f6b29b, 0x9c3b29620e29fc73,
+      0xa298f2c501f45f42, 0x8349f3ba91b47b8f, 0xcb3f2f7642717713, 0x241c70a936219a73,
+      0xfe0efb53d30dd4d7, 0xed238cd383aa0110, 0x9ec95d1463e8a506, 0xf4363804324a40aa,
+      0xc67bb4597ce2ce48, 0xb143c6053edcd0d5, 0xf81aa16fdc1b81da, 0xdd94b7868e94050a,
+      0x9b10a4e5e9913128, 0xca7cf2b4191c8326, 0xc1d4ce1f63f57d72, 0xfd1c2f611f63a3f0,
+      0xf24a01a73cf2dccf, 0xbc633b39673c8cec, 0x976e41088617ca01, 0xd5be0503e085d813,
+      0xbd49d14aa79dbc82, 0x4b2d8644d8a74e18, 0xec9c459d51852ba2, 0xddf8e7d60ed1219e,
+      0x93e1ab8252f33b45, 0xcabb90e5c942b503, 0xb8da1662e7b00a17, 0x3d6a751f3b936243,
+      0xe7109bfba19c0c9d, 0x0cc512670a783ad4, 0x906a617d450187e2, 0x27fb2b80668b24c5,
+      0xb484f9dc9641e9da, 0xb1f9f660802dedf6, 0xe1a63853bbd26451, 0x5e7873f8a0396973,
+      0x8d07e33455637eb2, 0xdb0b487b6423e1e8, 0xb049dc016abc5e5f, 0x91ce1a9a3d2cda62,
+      0xdc5c5301c56b75f7, 0x7641a140cc7810fb, 0x89b9b3e11b6329ba, 0xa9e904c87fcb0a9d,
+      0xac2820d9623bf429, 0x546345fa9fbdcd44, 0xd732290fbacaf133, 0xa97c177947ad4095,
+      0x867f59a9d4bed6c0, 0x49ed8eabcccc485d, 0xa81f301449ee8c70, 0x5c68f256bfff5a74,
+      0xd226fc195c6a2f8c, 0x73832eec6fff3111, 0x83585d8fd9c25db7, 0xc831fd53c5ff7eab,
+      0xa42e74f3d032f525, 0xba3e7ca8b77f5e55, 0xcd3a1230c43fb26f, 0x28ce1bd2e55f35eb,
+      0x80444b5e7aa7cf85, 0x7980d163cf5b81b3, 0xa0555e361951c366, 0xd7e105bcc332621f,
+      0xc86ab5c39fa63440, 0x8dd9472bf3fefaa7, 0xfa856334878fc150, 0xb14f98f6f0feb951,
+      0x9c935e00d4b9d8d2, 0x6ed1bf9a569f33d3, 0xc3b8358109e84f07, 0x0a862f80ec4700c8,
+      0xf4a642e14c6262c8, 0xcd27bb612758c0fa, 0x98e7e9cccfbd7dbd, 0x8038d51cb897789c,
+      0xbf21e44003acdd2c, 0xe0470a63e6bd56c3, 0xeeea5d5004981478, 0x1858ccfce06cac74,
+      0x95527a5202df0ccb, 0x0f37801e0c43ebc8, 0xbaa718e68396cffd, 0xd30560258f54e6ba,
+      0xe950df20247c83fd, 0x47c6b82ef32a2069, 0x91d28b7416cdd27e, 0x4cdc331d57fa5441,
+      0xb6472e511c81471d, 0xe0133fe4adf8e952, 0xe3d8f9e563a198e5, 0x58180fddd97723a6,
+      0x8e679c2f5e44ff8f, 0x570f09eaa7ea7648, 0xb201833b35d63f73, 0x2cd2cc6551e513da,
+      0xde81e40a034bcf4f, 0xf8077f7ea65e58d1, 0x8b112e86420f6191, 0xfb04afaf27faf782,
+      0xadd57a27d29339f6, 0x79c5db9af1f9b563, 0xd94ad8b1c7380874, 0x18375281ae7822bc,
+      0x87cec76f1c830548, 0x8f2293910d0b15b5, 0xa9c2794ae3a3c69a, 0xb2eb3875504ddb22,
+      0xd433179d9c8cb841, 0x5fa60692a46151eb, 0x849feec281d7f328, 0xdbc7c41ba6bcd333,
+      0xa5c7ea73224deff3, 0x12b9b522906c0800, 0xcf39e50feae16bef, 0xd768226b34870a00,
+      0x81842f29f2cce375, 0xe6a1158300d46640, 0xa1e53af46f801c53, 0x60495ae3c1097fd0,
+      0xca5e89b18b602368, 0x385bb19cb14bdfc4, 0xfcf62c1dee382c42, 0x46729e03dd9ed7b5,
+      0x9e19db92b4e31ba9, 0x6c07a2c26a8346d1
+    };
+
+    // Schubfach algorithm, declared before the serializer
+    inline DecimalNumber toShortestDecimal(uint64_t bits) {
+      constexpr int minExponent = -1074;
+      constexpr uint64_t hiddenBit = uint64_t{ 1 } << 52;
+      const int biasedExponent = static_cast<int>(bits >> 52 & 0x7FF);
+      uint64_t c = bits & (hiddenBit - 1);
+      int q = minExponent;
+      if (biasedExponent != 0) {
+        c |= hiddenBit;
+        q = biasedExponent - 1075;
+        if (-52 <= q && q < 0 && (c & ((uint64_t{ 1 } << -q) - 1)) == 0) // small integer
+          return { c >> -q, 0 };
+      }
+      const uint64_t out = c & 1, cb = c << 2, cbr = cb + 2;
+      uint64_t cbl;
+      int k; // floor(log10(2^q)) or floor(log10(3/4 * 2^q)) for the asymmetric interval at the edge of binade
+      if (c != hiddenBit || q == minExponent) {
+        cbl = cb - 2;
+        k = static_cast<int>(q * int64_t{ 661971961083 } >> 41);
+      }
+      else {
+        cbl = cb - 1;
+        k = static_cast<int>((q * int64_t{ 661971961083 } - 274743187321) >> 41);
+      }
+      const int h = q + static_cast<int>(-k * int64_t{ 913124641741 } >> 38) + 2; // floor(log2(10^-k))
+      // g = floor(10^-k * 2^-r) + 1 in [2^125, 2^126) derived from the normalized 128 bit approximation of 5^-k
+      const size_t index = 2 * static_cast<size_t>(-k - MinPowerOfFive);
+      uint64_t high = PowersOfFive[index], low = PowersOfFive[index + 1];
+      if (-27 <= -k && -k < 0 && low-- == 0) // these are floor + 1, others truncations (see the table)
+        --high;
+      low = (high << 62 | low >> 2) + 1;
+      high = (high >> 2) + (low == 0 ? 1 : 0);
+      constexpr uint64_t mask63 = ~uint64_t{ 0 } >> 1;
+      const uint64_t g1 = high << 1 | low >> 63, g0 = low & mask63;
+      const auto roundToOdd = [g1, g0](uint64_t cp) { // (g * cp) >> 128 rounded to odd
+        const uint64_t x1 = multiplyFull(g0, cp).high;
+        const UInt128 y = multiplyFull(g1, cp);
+        const uint64_t z = (y.low >> 1) + x1;
+        return (y.high + (z >> 63)) | (((z & mask63) + mask63) >> 63);
+      };
+      const uint64_t vb = roundToOdd(cb << h), vbl = roundToOdd(cbl << h), vbr = roundToOdd(cbr << h);
+      const uint64_t s = vb >> 2;
+      { // try one digit less
+        const uint64_t sp10 = s / 10 * 10, tp10 = sp10 + 10;
+        const bool upin = vbl + out <= sp10 << 2, wpin = (tp10 << 2) + out <= vbr;
+        if (upin != wpin)
+          return { upin ? sp10 : tp10, k };
+      }
+      const uint64_t t = s + 1;
+      const bool uin = vbl + out <= s << 2, win = (t << 2) + out <= vbr;
+      if (uin != win)
+        return { uin ? s : t, k };
+      const uint64_t middle = (s + t) << 1;
+      return { vb < middle || vb == middle && (s & 1) == 0 ? s : t, k };
+    }
+
+    // converts w * 10^q into the closest double using Clinger's fast path or Eisel-Lemire algorithm,
+    // w must not be 0 and must be the exact decimal significand;
+    // returns false when the result is not a normal finite number or can't be rounded with certainty
+    inline bool decimalToDouble(uint64_t w, int64_t q, bool isNegative, double &result) {
+      if (q < MinPowerOfFive || q > MaxPowerOfFive)
+        return false;
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0 // no excess precision for intermediate values
+      // both operands are exact, so the only rounding is that of the operation itself
+      if (w <= (uint64_t{ 1 } << 53) && -22 <= q && q <= 22) {
+        constexpr double powersOfTen[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                           1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+        double d = static_cast<double>(w);
+        d = q < 0 ? d / powersOfTen[-q] : d * powersOfTen[q];
+        result = isNegative ? -d : d;
+        return true;
+      }
+#endif
+      const unsigned leadingZeros = countLeadingZeros(w);
+      w <<= leadingZeros;
+      const size_t index = 2 * static_cast<size_t>(q - MinPowerOfFive);
+      UInt128 product = multiplyFull(w, PowersOfFive[index]);
+      constexpr uint64_t precisionMask = ~uint64_t{ 0 } >> 55; // 9 bits below mantissa and rounding bit
+      if ((product.high & precisionMask) == precisionMask) { // the lower half of 5^q may affect rounding
+        const uint64_t secondHigh = multiplyFull(w, PowersOfFive[index + 1]).high;
+        product.low += secondHigh;
+        if (secondHigh > product.low)
+          ++product.high;
+        if (product.low == ~uint64_t{ 0 } && (product.high & precisionMask) == precisionMask &&
+            (q < -27 || q > 55)) // the approximation of 5^q is inexact and the error may cross the rounding boundary
+          return false;
+      }
+      const unsigned upperBit = static_cast<unsigned>(product.high >> 63);
+      const unsigned shift = upperBit + 9;
+      uint64_t mantissa = product.high >> shift;
+      // (217706 * q) >> 16 is floor(log2(10^q)) for q in [-342, 308]
+      int64_t exponent = ((217706 * q) >> 16) + 63 + upperBit - leadingZeros + 1023;
+      if (exponent <= 0) // subnormal numbers are rare, leave them to the fallback
+        return false;
+      // exactly halfway between two doubles is only possible for small q, round to even then
+      if (product.low <= 1 && -4 <= q && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == product.high)
+        mantissa &= ~uint64_t{ 1 };
+      mantissa += mantissa & 1;
+      mantissa >>= 1;
+      if (mantissa >= (uint64_t{ 2 } << 52)) { // rounding overflowed into the next binade
+        mantissa = uint64_t{ 1 } << 52;
+        ++exponent;
+      }
+      mantissa &= ~(uint64_t{ 1 } << 52);
+      if (exponent >= 0x7FF)
+        return false;
+      const uint64_t bits = mantissa | static_cast<uint64_t>(exponent) << 52 | static_cast<uint64_t>(isNegative) << 63;
+      std::memcpy(&result, &bits, sizeof(result));
+      return true;
+    }
     enum class EscapedStringParsingResult {
       Skip,
       Unescaped,
@@ -919,144 +3379,1078 @@ namespace minjson {
       }
 
     private:
-      void writePending(const char *pendingEnd) {
-        if (pendingBegin != pendingEnd)
-          sink(std::string_view{ pendingBegin, static_cast<size_t>(pendingEnd - pendingBegin) });
+      void writePending(const char *pendingEnd) {
+        if (pendingBegin != pendingEnd)
+          sink(std::string_view{ pendingBegin, static_cast<size_t>(pendingEnd - pendingBegin) });
+      }
+
+      Sink &&sink;
+      const char *pendingBegin;
+    };
+  }
+
+  namespace impl {
+    inline constexpr size_t NPos = ~size_t{ 0 };
+    inline constexpr char32_t DoNotReplaceSurrogates = ~char32_t{ 0 };
+    template<typename Sink>
+    size_t unescape(Sink &&sink,
+                    std::string_view input,
+                    UnescapeMode mode,
+                    char32_t surrogateReplacement = DoNotReplaceSurrogates) {
+      if (input.empty())
+        return 0;
+      detail::UnescapeParser<Sink> parser{ std::forward<Sink>(sink) };
+      const auto result =
+        mode == UnescapeMode::Relaxed ? parser.template unescape<UnescapeMode::Relaxed>(input, surrogateReplacement) :
+        /*mode == UnescapeMode::Strict*/parser.template unescape<UnescapeMode::Strict>(input, surrogateReplacement);
+      return result == nullptr ? NPos : result - input.data();
+    }
+  }
+
+  template<typename String_t = String>
+  [[nodiscard]] String_t unescape(std::string_view input, UnescapeMode unescapeMode = UnescapeMode::Strict) {
+    String_t s;
+    if (impl::unescape(detail::StringSink<String_t>{ s }, input, unescapeMode) == input.size())
+      return s;
+    return {};
+  }
+  template<typename String_t = String>
+  [[nodiscard]] String_t unescape(std::string_view input,
+                                  UnescapeMode unescapeMode,
+                                  char32_t unpairedSurrogateReplacement) {
+    String_t s;
+    if (impl::unescape(detail::StringSink<String_t>{ s }, input, unescapeMode, unpairedSurrogateReplacement) == input.size())
+      return s;
+    return {};
+  }
+
+
+  struct ParsingOptions {
+    enum class Option {
+      Ignore,
+      Report,
+      Fail
+    };
+    Option duplicateObjectKeys = Option::Fail;
+    Option unpairedUtf16Surrogates = Option::Ignore;
+    bool replaceInvalidUtf16Surrogates = false;
+    char32_t replacement = U'\xfffd'; // replacement character �
+    Utf8Validation validation = {}; // of string contents
+    enum class Engine {
+      Default,
+      StructuralIndex // classifies input in blocks of 64 bytes first, then parses jumping between structural characters
+    };
+    Engine engine = Engine::Default;
+    // of nested arrays and objects, default also guards recursive destruction, copying, comparison and serialization
+    size_t maxDepth = 1024;
+    KeyDictionary *keyDictionary = nullptr; // to intern keys of objects which can borrow characters
+  };
+
+  struct ParsingIssue {
+    enum class Code {
+      Other,
+      InvalidCharacter,
+      UnexpectedEndOfInput,
+      FailedToParseNumber,
+      ParsedNumberOutOfRange,
+      DuplicateKeys,
+      StringContainsUnpairedUtf16HighSurrogate,
+      StringContainsUnpairedUtf16LowSurrogate,
+      StringContainsInvalidUtf8CodeUnits,
+      MaxDepthExceeded
+    };
+    size_t offset;
+    std::string_view description;
+    Code code = {};
+  };
+
+  namespace detail {
+    inline bool skipWhitespaces(const char *&begin, const char *end) {
+      while (begin != end) {
+        switch (*begin) {
+        default:
+          return false;
+
+        case '\t':
+        case '\n':
+        case '\r':
+        case ' ':
+          ++begin;
+        }
+      }
+      return true;
+    }
+    inline bool isWhitespace(char c) { return c == ' ' || c == '\n' || c == '\r' || c == '\t'; }
+
+    struct CharacterBlock final { // bit per character of a 64 byte block
+      uint64_t quotes = 0, backslashes = 0, controls = 0, structurals = 0, whitespaces = 0;
+      explicit CharacterBlock(const char *p) {
+#if defined(MINJSONCPP_SIMD)
+        for (size_t k = 0; k < 64; k += SimdVector::Size) {
+          const auto v = SimdVector::load(p + k);
+          quotes |= uint64_t{ v.equals('\"').mask() } << k;
+          backslashes |= uint64_t{ v.equals('\\').mask() } << k;
+          controls |= uint64_t{ v.isControlCharacter().mask() } << k;
+          structurals |= uint64_t{ (v.equals('{') | v.equals('}') | v.equals('[') | v.equals(']') |
+                                    v.equals(':') | v.equals(',')).mask() } << k;
+          whitespaces |= uint64_t{ (v.equals(' ') | v.equals('\n') | v.equals('\r') | v.equals('\t')).mask() } << k;
+        }
+#else
+        for (size_t k = 0; k < 64; ++k) {
+          const uint64_t bit = uint64_t{ 1 } << k;
+          switch (p[k]) {
+          case '\"': quotes |= bit; break;
+          case '\\': backslashes |= bit; break;
+          case '{': case '}': case '[': case ']': case ':': case ',': structurals |= bit; break;
+          case ' ': case '\n': case '\r': case '\t': whitespaces |= bit; break;
+          }
+          if (isControlCharacter(p[k]))
+            controls |= bit;
+        }
+#endif
+      }
+    };
+    inline uint64_t findEscapedCharacters(uint64_t backslashes, uint64_t &isPrevEscaped) {
+      constexpr uint64_t evenBits = 0x5555555555555555u;
+      backslashes &= ~isPrevEscaped;
+      const uint64_t followsEscape = backslashes << 1 | isPrevEscaped;
+      const uint64_t oddSequenceStarts = backslashes & ~evenBits & ~followsEscape;
+      const uint64_t sequencesStartingOnEvenBits = oddSequenceStarts + backslashes;
+      isPrevEscaped = sequencesStartingOnEvenBits < oddSequenceStarts ? 1 : 0; // carry
+      return (evenBits ^ sequencesStartingOnEvenBits << 1) & followsEscape;
+    }
+    inline uint64_t prefixXor(uint64_t x) {
+      x ^= x << 1;
+      x ^= x << 2;
+      x ^= x << 4;
+      x ^= x << 8;
+      x ^= x << 16;
+      x ^= x << 32;
+      return x;
+    }
+    // Positions of structural characters and quotation marks outside of strings, and of the first characters of
+    // literals and numbers, terminated by the input size.
+    template<typename Allocator>
+    struct StructuralIndex final {
+      static constexpr uint32_t DirtyStringFlag = 0x80000000u; // set on closing quotation marks of strings
+                                                               // containing escapes or control characters
+      static constexpr size_t MaxInputSize = DirtyStringFlag - 1;
+
+      StructuralIndex(const Allocator &allocator) : positions{ allocator } {}
+      void build(std::string_view input) {
+        positions.reserve(input.size() / 4 + 1);
+        uint64_t isPrevEscaped = 0, prevInString = 0, prevSeparator = 1;
+        bool isStringDirty = false;
+        for (size_t base = 0; base < input.size(); base += 64) {
+          char padded[64];
+          const char *p = input.data() + base;
+          if (input.size() - base < 64) {
+            std::fill(std::copy(p, input.data() + input.size(), padded), padded + 64, ' ');
+            p = padded;
+          }
+          const CharacterBlock block{ p };
+          const uint64_t quotes = block.quotes & ~findEscapedCharacters(block.backslashes, isPrevEscaped);
+          const uint64_t inString = prefixXor(quotes) ^ prevInString;
+          const uint64_t separators = block.structurals | block.whitespaces;
+          const uint64_t scalarStarts = ~(separators | quotes | inString) & (separators << 1 | prevSeparator);
+          const uint64_t dirty = (block.backslashes | block.controls) & inString;
+          uint64_t stringMask = ~uint64_t{ 0 };
+          for (uint64_t e = (block.structurals & ~inString) | quotes | scalarStarts; e; e &= e - 1) {
+            const unsigned k = countTrailingZeros(e);
+            const uint64_t bit = uint64_t{ 1 } << k;
+            uint32_t position = static_cast<uint32_t>(base + k);
+            if (quotes & bit) {
+              if (inString & bit) { // opening quotation mark
+                isStringDirty = false;
+                stringMask = ~((bit << 1) - 1);
+              }
+              else if (isStringDirty || (dirty & stringMask & (bit - 1))) {
+                position |= DirtyStringFlag;
+              }
+            }
+            positions.push_back(position);
+          }
+          prevInString = static_cast<uint64_t>(static_cast<int64_t>(inString) >> 63);
+          if (prevInString)
+            isStringDirty |= (dirty & stringMask) != 0;
+          prevSeparator = separators >> 63;
+        }
+        positions.push_back(static_cast<uint32_t>(input.size()));
+      }
+
+      std::vector<uint32_t, ReboundAllocator<Allocator, uint32_t>> positions;
+    };
+    struct ParserImplBase {
+      ParserImplBase(std::string_view input, const ParsingOptions &options) : input{ input }, options{ options },
+        surrogateReplacement{ options.replaceInvalidUtf16Surrogates ? options.replacement : ~char32_t{ 0 } },
+        i{ input.data() }, end{ input.data() + input.size() } {}
+      size_t parsedSize() const { return static_cast<size_t>(i - input.data()); }
+
+    protected:
+      bool isInputEmpty() const { return i == end; }
+
+      const std::string_view input;
+      const ParsingOptions &options;
+      const char32_t surrogateReplacement;
+      const char *i;
+      const char *const end;
+    };
+
+    // writes unescaped string contents over their escaped representation which is never shorter
+    struct InSituStringWriter final {
+      InSituStringWriter &append(const char *first, const char *last) {
+        if (validate && !invalid) {
+          if (const char *p = findInvalidUtf8CodePoint(first, last); p != last)
+            invalid = p;
+        }
+        if (out != first)
+          std::memmove(out, first, static_cast<size_t>(last - first));
+        out += last - first;
+        return *this;
+      }
+      InSituStringWriter &operator+=(std::string_view s) {
+        std::memcpy(out, s.data(), s.size());
+        out += s.size();
+        return *this;
+      }
+
+      char *out;
+      const bool validate;
+      const char *invalid = nullptr; // first invalid UTF-8 code point in the escaped representation
+    };
+
+    // builders store parsed values, parser passes slots of values being parsed to them
+    template<typename Allocator, typename Policy>
+    struct ValueBuilder final {
+      using Value = BasicValue<Allocator, Policy>;
+      using String = typename Value::String;
+      using Slot = typename Value::Variant*;
+
+      void null(Slot v) { v->template emplace<Null>(); }
+      void boolean(Slot v, bool b) { v->template emplace<bool>(b); }
+      void integer(Slot v, int64_t i) { v->template emplace<int64_t>(i); }
+      void decimal(Slot v, double d) { v->template emplace<double>(d); }
+
+      String &string(Slot v) { return v->template emplace<String>(allocator); }
+      void endString(Slot, String&) {}
+
+      struct InPlaceVector {
+        static constexpr size_t Capacity = 42;
+        union {
+          Value b[Capacity];
+        };
+        size_t size = 0;
+        InPlaceVector() {}
+        ~InPlaceVector() { std::destroy_n(b, size); }
+        auto &emplace_back() {
+          ::new(b + size) Value;
+          return b[size++];
+        }
+      };
+      struct ArrayBuilder {
+        typename Value::Array &a;
+        InPlaceVector b; // first members are parsed here to allocate the array only once for small arrays
+      };
+      ArrayBuilder array(Slot v) { return { v->template emplace<typename Value::Array>(allocator) }; }
+      Slot element(ArrayBuilder &a) {
+        if (a.b.size != a.b.Capacity)
+          return &a.b.emplace_back().variant();
+        if (a.a.empty()) {
+          a.a.reserve(a.b.size + 1);
+          a.a.assign(std::make_move_iterator(a.b.b), std::make_move_iterator(a.b.b + a.b.size));
+        }
+        return &a.a.emplace_back().variant();
+      }
+      void endArray(ArrayBuilder &a) {
+        if (a.a.empty())
+          a.a.assign(std::make_move_iterator(a.b.b), std::make_move_iterator(a.b.b + a.b.size));
+      }
+
+      struct ObjectBuilder {
+        typename Value::Object &o;
+      };
+      struct Member {
+        Slot value;
+        bool isInserted;
+      };
+      ObjectBuilder object(Slot v) { return { v->template emplace<typename Value::Object>(allocator) }; }
+      using Key = typename Value::Object::key_type;
+      Key key(ObjectBuilder&) { return Key{ allocator }; }
+      Member member(ObjectBuilder &o, Key &key) {
+        if constexpr (CanBorrowCharacters<Key>) {
+          if (keyCache.dictionary)
+            key.borrow(keyCache.intern(key));
+          else if (!CanBorrowCharacters<String> && key.isBorrowed()) // only zero-copy values may refer to the input
+            key = Key{ std::string_view{ key }, allocator };
+        }
+        const auto [it, isInserted] = tryEmplaceMember(o.o, std::move(key));
+        return { &it->second.variant(), isInserted };
+      }
+      void endObject(ObjectBuilder &o) { sortMembers(o.o); }
+
+      Allocator allocator;
+      KeyCache keyCache;
+    };
+
+    // detects duplicate keys of objects being parsed, keys are identified by offsets in strings
+    template<typename Allocator>
+    struct DuplicateKeyDetector final {
+      using Strings = std::vector<char, ReboundAllocator<Allocator, char>>;
+      struct Key {
+        size_t offset;
+        size_t size;
+      };
+      struct KeyHash {
+        size_t operator()(Key k) const noexcept { return std::hash<std::string_view>{}({ strings->data() + k.offset, k.size }); }
+        const Strings *strings;
+      };
+      struct KeyEqual {
+        bool operator()(Key a, Key b) const noexcept { // no memcmp(), data is null while all keys are empty
+          return std::string_view{ strings->data() + a.offset, a.size } ==
+                 std::string_view{ strings->data() + b.offset, b.size };
+        }
+        const Strings *strings;
+      };
+      using KeySet = std::unordered_set<Key, KeyHash, KeyEqual, ReboundAllocator<Allocator, Key>>;
+      static constexpr size_t MaxLinearlySearchedKeys = 16;
+      struct ObjectKeys {
+        size_t keysBegin; // keys of small objects are searched linearly in keys, of large ones in keySet
+        std::optional<KeySet> keySet;
+      };
+
+      explicit DuplicateKeyDetector(const Allocator &allocator) : keys{ allocator } {}
+
+      ObjectKeys object() const { return { keys.size(), std::nullopt }; }
+      bool insert(ObjectKeys &o, Key k, const Strings &strings) {
+        if (o.keySet)
+          return o.keySet->insert(k).second;
+        const KeyEqual equal{ &strings };
+        const bool isInserted = std::none_of(keys.begin() + o.keysBegin, keys.end(), [&](Key other) { return equal(k, other); });
+        if (isInserted)
+          keys.push_back(k);
+        if (keys.size() - o.keysBegin > MaxLinearlySearchedKeys) {
+          o.keySet.emplace(keys.begin() + o.keysBegin, keys.end(), 0, KeyHash{ &strings }, equal, keys.get_allocator());
+          keys.resize(o.keysBegin);
+        }
+        return isInserted;
+      }
+      void endObject(ObjectKeys &o) { keys.resize(o.keysBegin); }
+
+    private:
+      std::vector<Key, ReboundAllocator<Allocator, Key>> keys;
+    };
+
+    // detects duplicate keys of members which builders skip (and containers cannot detect them), keys are copied
+    template<typename Allocator>
+    struct SkippedKeyDetector final {
+      using Keys = DuplicateKeyDetector<Allocator>;
+      struct ObjectKeys {
+        typename Keys::ObjectKeys keys;
+        size_t stringsSize;
+      };
+
+      SkippedKeyDetector(bool isEnabled, const Allocator &allocator) :
+        isEnabled{ isEnabled }, strings{ allocator }, keys{ allocator } {}
+
+      ObjectKeys object() const { return { keys.object(), strings.size() }; }
+      bool insert(ObjectKeys &o, std::string_view k) {
+        if (!isEnabled)
+          return true;
+        const size_t offset = strings.size();
+        strings.insert(strings.end(), k.begin(), k.end());
+        return keys.insert(o.keys, { offset, k.size() }, strings);
+      }
+      void endObject(ObjectKeys &o) {
+        if (isEnabled) {
+          keys.endObject(o.keys);
+          strings.resize(o.stringsSize);
+        }
+      }
+
+      const bool isEnabled;
+
+    private:
+      typename Keys::Strings strings;
+      Keys keys;
+    };
+
+    template<typename Allocator>
+    struct TapeBuilder final {
+      using Document = BasicDocument<Allocator>;
+      struct Slot {};
+
+      explicit TapeBuilder(Document &document) :
+        tape{ document.tape }, strings{ document.strings }, keys{ document.tape.get_allocator() } {}
+
+      void null(Slot) { tape.push_back(makeTapeWord(TapeTag::Null)); }
+      void boolean(Slot, bool b) { tape.push_back(makeTapeWord(b ? TapeTag::True : TapeTag::False)); }
+      void integer(Slot, int64_t i) {
+        tape.push_back(makeTapeWord(TapeTag::Integer));
+        tape.push_back(static_cast<uint64_t>(i));
+      }
+      void decimal(Slot, double d) {
+        uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        tape.push_back(makeTapeWord(TapeTag::Decimal));
+        tape.push_back(bits);
+      }
+
+      struct StringWriter {
+        StringWriter &append(const char *first, const char *last) {
+          strings.insert(strings.end(), first, last);
+          return *this;
+        }
+        StringWriter &operator+=(std::string_view s) { return append(s.data(), s.data() + s.size()); }
+
+        typename Document::Strings &strings;
+        const size_t offset;
+      };
+      StringWriter string(Slot) { return { strings, strings.size() }; }
+      void endString(Slot, StringWriter &s) { pushString(s); }
+
+      struct ArrayBuilder {
+        size_t start;
+        uint64_t size = 0;
+      };
+      ArrayBuilder array(Slot) { return { openContainer() }; }
+      Slot element(ArrayBuilder &a) {
+        ++a.size;
+        return {};
+      }
+      void endArray(ArrayBuilder &a) { closeContainer(TapeTag::Array, a.start, a.size); }
+
+      using Keys = DuplicateKeyDetector<Allocator>;
+      struct Marks {
+        size_t tapeSize;
+        size_t stringsSize;
+      };
+      struct ObjectBuilder {
+        size_t start;
+        uint64_t size;
+        typename Keys::ObjectKeys keys;
+        std::optional<Marks> duplicateMember; // tape can't be searched for keys, so first member with a key is kept
+      };
+      struct Member {
+        Slot value;
+        bool isInserted;
+      };
+      ObjectBuilder object(Slot) { return { openContainer(), 0, keys.object(), std::nullopt }; }
+      StringWriter key(ObjectBuilder &o) {
+        discardDuplicateMember(o);
+        return { strings, strings.size() };
+      }
+      Member member(ObjectBuilder &o, StringWriter &key) {
+        const bool isInserted = keys.insert(o.keys, { key.offset, strings.size() - key.offset }, strings);
+        if (isInserted)
+          ++o.size;
+        else
+          o.duplicateMember = Marks{ tape.size(), key.offset };
+        pushString(key);
+        return { {}, isInserted };
+      }
+      void endObject(ObjectBuilder &o) {
+        discardDuplicateMember(o);
+        keys.endObject(o.keys);
+        closeContainer(TapeTag::Object, o.start, o.size);
+      }
+
+      void discard() {
+        tape.clear();
+        strings.clear();
+      }
+
+    private:
+      void discardDuplicateMember(ObjectBuilder &o) {
+        if (o.duplicateMember) {
+          tape.resize(o.duplicateMember->tapeSize);
+          strings.resize(o.duplicateMember->stringsSize);
+          o.duplicateMember.reset();
+        }
+      }
+      void pushString(const StringWriter &s) {
+        tape.push_back(makeTapeWord(TapeTag::String, s.offset));
+        tape.push_back(strings.size() - s.offset);
+      }
+      size_t openContainer() {
+        const size_t start = tape.size();
+        tape.resize(start + 2); // filled when the container is closed
+        return start;
+      }
+      void closeContainer(TapeTag tag, size_t start, uint64_t size) {
+        tape[start] = makeTapeWord(tag, tape.size() - start);
+        tape[start + 1] = size;
+      }
+
+      typename Document::Tape &tape;
+      typename Document::Strings &strings;
+      Keys keys;
+    };
+
+    // forwards parsed values to the handler as events
+    template<typename Allocator, typename Handler>
+    struct SaxBuilder final {
+      struct Slot {};
+      using Keys = DuplicateKeyDetector<Allocator>;
+
+      SaxBuilder(Handler &handler, bool detectDuplicateKeys, const Allocator &allocator) :
+        handler{ handler }, detectDuplicateKeys{ detectDuplicateKeys }, buffer{ allocator },
+        keyStrings{ allocator }, keys{ allocator } {}
+
+      void null(Slot) { handler.null(); }
+      void boolean(Slot, bool b) { handler.boolean(b); }
+      void integer(Slot, int64_t i) { handler.integer(i); }
+      void decimal(Slot, double d) { handler.decimal(d); }
+
+      // strings without escapes refer to the input, others are unescaped into the buffer
+      struct StringWriter {
+        void borrow(std::string_view s) { borrowed = s; }
+        StringWriter &append(const char *first, const char *last) {
+          buffer.append(first, last);
+          return *this;
+        }
+        StringWriter &operator+=(std::string_view s) {
+          buffer += s;
+          return *this;
+        }
+        std::string_view view() const { return borrowed.data() ? borrowed : std::string_view{ buffer }; }
+
+        std::basic_string<char, std::char_traits<char>, ReboundAllocator<Allocator, char>> &buffer;
+        std::string_view borrowed = {};
+      };
+      StringWriter string(Slot) {
+        buffer.clear();
+        return { buffer };
+      }
+      void endString(Slot, const StringWriter &s) { handler.string(s.view()); }
+
+      struct ArrayBuilder {};
+      ArrayBuilder array(Slot) {
+        handler.startArray();
+        return {};
+      }
+      Slot element(ArrayBuilder&) { return {}; }
+      void endArray(ArrayBuilder&) { handler.endArray(); }
+
+      struct ObjectBuilder {
+        typename Keys::ObjectKeys keys;
+        size_t keyStringsSize;
+      };
+      struct Member {
+        Slot value;
+        bool isInserted;
+      };
+      ObjectBuilder object(Slot) {
+        handler.startObject();
+        return { keys.object(), keyStrings.size() };
+      }
+      StringWriter key(ObjectBuilder&) { return string({}); }
+      Member member(ObjectBuilder &o, const StringWriter &key) {
+        const std::string_view k = key.view();
+        bool isInserted = true;
+        if (detectDuplicateKeys) { // keys are copied since the buffer is reused
+          const size_t offset = keyStrings.size();
+          keyStrings.insert(keyStrings.end(), k.begin(), k.end());
+          isInserted = keys.insert(o.keys, { offset, k.size() }, keyStrings);
+        }
+        handler.key(k);
+        return { {}, isInserted };
+      }
+      void endObject(ObjectBuilder &o) {
+        if (detectDuplicateKeys) {
+          keys.endObject(o.keys);
+          keyStrings.resize(o.keyStringsSize);
+        }
+        handler.endObject();
+      }
+
+    private:
+      Handler &handler;
+      const bool detectDuplicateKeys;
+      std::basic_string<char, std::char_traits<char>, ReboundAllocator<Allocator, char>> buffer;
+      typename Keys::Strings keyStrings;
+      Keys keys;
+    };
+
+    // locates raw JSON text of values designated by JSON Pointers, other values are validated but not stored,
+    // and keys are kept only for members of values having designated members or to detect duplicate keys
+    template<typename Allocator>
+    struct JsonPointerSetBuilder final {
+      using Set = BasicJsonPointerSet<Allocator>;
+      using Slot = size_t; // node of the set, Set::NoNode for values not containing designated values
+      using Buffer = std::basic_string<char, std::char_traits<char>, ReboundAllocator<Allocator, char>>;
+
+      void null(Slot) {}
+      void boolean(Slot, bool) {}
+      void integer(Slot, int64_t) {}
+      void decimal(Slot, double) {}
+
+      // discards characters if there is no buffer
+      struct StringWriter {
+        void borrow(std::string_view s) { borrowed = s; }
+        StringWriter &append(const char *first, const char *last) {
+          if (buffer)
+            buffer->append(first, last);
+          return *this;
+        }
+        StringWriter &operator+=(std::string_view s) {
+          if (buffer)
+            *buffer += s;
+          return *this;
+        }
+        std::string_view view() const { return borrowed.data() ? borrowed : std::string_view{ *buffer }; }
+
+        Buffer *buffer;
+        std::string_view borrowed = {};
+      };
+      StringWriter string(Slot) { return { nullptr }; }
+      void endString(Slot, const StringWriter&) {}
+
+      struct ArrayBuilder {
+        Slot node;
+        size_t size;
+      };
+      ArrayBuilder array(Slot v) { return { v, 0 }; }
+      Slot element(ArrayBuilder &a) {
+        const size_t index = a.size++;
+        return hasChildren(a.node) ? set.child(a.node, index) : Set::NoNode;
+      }
+      void endArray(ArrayBuilder&) {}
+
+      // no members are stored, so all keys are kept by keys unless duplicate keys are ignored
+      struct ObjectBuilder {
+        Slot node;
+        typename SkippedKeyDetector<Allocator>::ObjectKeys keys;
+      };
+      struct Member {
+        Slot value;
+        bool isInserted;
+      };
+      ObjectBuilder object(Slot v) { return { v, keys.object() }; }
+      StringWriter key(ObjectBuilder &o) {
+        if (!hasChildren(o.node) && !keys.isEnabled)
+          return { nullptr };
+        buffer.clear();
+        return { &buffer };
+      }
+      Member member(ObjectBuilder &o, const StringWriter &key) {
+        const bool isInserted = !keys.isEnabled || keys.insert(o.keys, key.view());
+        return { hasChildren(o.node) ? set.child(o.node, key.view()) : Set::NoNode, isInserted };
+      }
+      void endObject(ObjectBuilder &o) { keys.endObject(o.keys); }
+
+      void valueSpan(Slot v, const char *begin, const char *end) {
+        if (v != Set::NoNode && set.nodes[v].pointer != Set::NoNode)
+          values[set.nodes[v].pointer] = { begin, static_cast<size_t>(end - begin) };
+      }
+
+      void copyDuplicates() { set.copyDuplicates(values); }
+
+      const Set &set;
+      std::string_view *values;
+      Buffer buffer;
+      SkippedKeyDetector<Allocator> keys;
+
+    private:
+      bool hasChildren(Slot v) const { return v != Set::NoNode && set.nodes[v].firstChild != Set::NoNode; }
+    };
+    // builds only values designated by JSON Pointers and their ancestors (containers), other values are validated
+    // but not stored; elements of arrays that are not designated are replaced with nulls to preserve indices
+    template<typename Allocator, typename Policy>
+    struct ProjectingValueBuilder final {
+      using Set = BasicJsonPointerSet<Allocator>;
+      using Value = BasicValue<Allocator, Policy>;
+      using String = typename Value::String;
+      using Variant = typename Value::Variant;
+      // node of the set for values containing designated values, Whole for designated values and their members,
+      // value is null for values that are skipped
+      struct Slot {
+        Variant *value;
+        size_t node;
+      };
+      static constexpr size_t Whole = Set::NoNode - 1;
+
+      Slot root(Variant &v) const { return { &v, node(0) }; }
+
+      void null(Slot v) {
+        if (v.value)
+          v.value->template emplace<Null>();
+      }
+      void boolean(Slot v, bool b) {
+        if (v.value)
+          v.value->template emplace<bool>(b);
+      }
+      void integer(Slot v, int64_t i) {
+        if (v.value)
+          v.value->template emplace<int64_t>(i);
+      }
+      void decimal(Slot v, double d) {
+        if (v.value)
+          v.value->template emplace<double>(d);
+      }
+
+      // discards characters if there is no string
+      struct StringWriter {
+        StringWriter &append(const char *first, const char *last) {
+          if (s)
+            s->append(first, last);
+          return *this;
+        }
+        StringWriter &operator+=(std::string_view chars) {
+          if (s)
+            *s += chars;
+          return *this;
+        }
+
+        String *s;
+      };
+      struct BorrowingStringWriter : StringWriter {
+        void borrow(std::string_view chars) {
+          if (this->s)
+            this->s->borrow(chars);
+        }
+      };
+      using Writer = std::conditional_t<CanBorrowCharacters<String>, BorrowingStringWriter, StringWriter>;
+      Writer string(Slot v) {
+        if (!v.value)
+          return { { nullptr } };
+        return { { &v.value->template emplace<String>(allocator) } };
+      }
+      void endString(Slot, const Writer&) {}
+
+      struct ArrayBuilder {
+        typename Value::Array *a;
+        size_t node;
+      };
+      ArrayBuilder array(Slot v) {
+        if (!v.value)
+          return { nullptr, Set::NoNode };
+        return { &v.value->template emplace<typename Value::Array>(allocator), v.node };
+      }
+      Slot element(ArrayBuilder &a) {
+        if (!a.a)
+          return { nullptr, Set::NoNode };
+        const size_t index = a.a->size();
+        Variant &element = a.a->emplace_back().variant();
+        if (a.node == Whole)
+          return { &element, Whole };
+        const size_t c = set.child(a.node, index);
+        return c != Set::NoNode ? Slot{ &element, node(c) } : Slot{ nullptr, Set::NoNode };
+      }
+      void endArray(ArrayBuilder&) {}
+
+      // keys of skipped members are kept by skippedKeys unless duplicate keys are ignored
+      struct ObjectBuilder {
+        typename Value::Object *o;
+        size_t node;
+        typename SkippedKeyDetector<Allocator>::ObjectKeys skipped;
+      };
+      struct Member {
+        Slot value;
+        bool isInserted;
+      };
+      ObjectBuilder object(Slot v) {
+        if (!v.value)
+          return { nullptr, Set::NoNode, skippedKeys.object() };
+        return { &v.value->template emplace<typename Value::Object>(allocator), v.node, skippedKeys.object() };
+      }
+      Writer key(ObjectBuilder &o) {
+        if (!o.o && !skippedKeys.isEnabled)
+          return { { nullptr } };
+        keyBuffer = String{ allocator };
+        return { { &keyBuffer } };
+      }
+      Member member(ObjectBuilder &o, const Writer&) {
+        if (!o.o)
+          return { { nullptr, Set::NoNode }, skippedKeys.insert(o.skipped, std::string_view{ keyBuffer }) };
+        size_t c = Whole;
+        if (o.node != Whole) {
+          c = set.child(o.node, std::string_view{ keyBuffer });
+          if (c == Set::NoNode)
+            return { { nullptr, Set::NoNode }, skippedKeys.insert(o.skipped, std::string_view{ keyBuffer }) };
+          c = node(c);
+        }
+        const auto [it, isInserted] = tryEmplaceMember(*o.o, takeKey());
+        return { { &it->second.variant(), c }, isInserted };
+      }
+      void endObject(ObjectBuilder &o) {
+        skippedKeys.endObject(o.skipped);
+        if (o.o)
+          sortMembers(*o.o);
+      }
+
+      const Set &set;
+      Allocator allocator;
+      String keyBuffer;
+      KeyCache keyCache;
+      SkippedKeyDetector<Allocator> skippedKeys;
+
+    private:
+      size_t node(size_t n) const { return set.nodes[n].pointer != Set::NoNode ? Whole : n; }
+      auto takeKey() {
+        using Key = typename Value::Object::key_type;
+        Key key = [this] {
+          if constexpr (std::is_same_v<Key, String>)
+            return std::move(keyBuffer);
+          else
+            return Key{ std::string_view{ keyBuffer }, allocator };
+        }();
+        if constexpr (CanBorrowCharacters<Key>) {
+          if (keyCache.dictionary)
+            key.borrow(keyCache.intern(key));
+        }
+        return key;
       }
-
-      Sink &&sink;
-      const char *pendingBegin;
     };
-  }
-
-  namespace impl {
-    inline constexpr size_t NPos = ~size_t{ 0 };
-    inline constexpr char32_t DoNotReplaceSurrogates = ~char32_t{ 0 };
-    template<typename Sink>
-    size_t unescape(Sink &&sink,
-                    std::string_view input,
-                    UnescapeMode mode,
-                    char32_t surrogateReplacement = DoNotReplaceSurrogates) {
-      if (input.empty())
-        return 0;
-      detail::UnescapeParser<Sink> parser{ std::forward<Sink>(sink) };
-      const auto result =
-        mode == UnescapeMode::Relaxed ? parser.template unescape<UnescapeMode::Relaxed>(input, surrogateReplacement) :
-        /*mode == UnescapeMode::Strict*/parser.template unescape<UnescapeMode::Strict>(input, surrogateReplacement);
-      return result == nullptr ? NPos : result - input.data();
-    }
-  }
-
-  template<typename String_t = String>
-  [[nodiscard]] String_t unescape(std::string_view input, UnescapeMode unescapeMode = UnescapeMode::Strict) {
-    String_t s;
-    if (impl::unescape(detail::StringSink<String_t>{ s }, input, unescapeMode) == input.size())
-      return s;
-    return {};
-  }
-  template<typename String_t = String>
-  [[nodiscard]] String_t unescape(std::string_view input,
-                                  UnescapeMode unescapeMode,
-                                  char32_t unpairedSurrogateReplacement) {
-    String_t s;
-    if (impl::unescape(detail::StringSink<String_t>{ s }, input, unescapeMode, unpairedSurrogateReplacement) == input.size())
-      return s;
-    return {};
-  }
 
+    template<typename Builder, typename = void>
+    inline constexpr bool LocatesValues = false;
+    template<typename Builder>
+    inline constexpr bool LocatesValues<Builder, std::void_t<decltype(&Builder::valueSpan)>> = true;
 
-  struct ParsingOptions {
-    enum class Option {
-      Ignore,
-      Report,
-      Fail
-    };
-    Option duplicateObjectKeys = Option::Fail;
-    Option unpairedUtf16Surrogates = Option::Ignore;
-    bool replaceInvalidUtf16Surrogates = false;
-    char32_t replacement = U'\xfffd'; // replacement character �
-  };
-
-  struct ParsingIssue {
-    enum class Code {
-      Other,
-      InvalidCharacter,
-      UnexpectedEndOfInput,
-      FailedToParseNumber,
-      ParsedNumberOutOfRange,
-      DuplicateKeys,
-      StringContainsUnpairedUtf16HighSurrogate,
-      StringContainsUnpairedUtf16LowSurrogate
-    };
-    size_t offset;
-    std::string_view description;
-    Code code = {};
-  };
+    // stack of frames with stable addresses (slots of values being parsed may refer to contents of enclosing frames),
+    // first frames are stored in place, others in blocks of memory which are reused until the stack is destroyed
+    template<typename Frame, typename Allocator>
+    struct FrameStack final {
+      explicit FrameStack(const Allocator &a) : allocator{ a }, blocks{ a } {}
+      FrameStack(const FrameStack&) = delete;
+      FrameStack &operator=(const FrameStack&) = delete;
+      ~FrameStack() {
+        clear();
+        for (Frame *block : blocks)
+          Traits::deallocate(allocator, block, BlockSize);
+      }
 
-  namespace detail {
-    inline bool skipWhitespaces(const char *&begin, const char *end) {
-      while (begin != end) {
-        switch (*begin) {
-        default:
-          return false;
+      [[nodiscard]] size_t size() const noexcept { return count; }
+      [[nodiscard]] bool empty() const noexcept { return count == 0; }
+      [[nodiscard]] Frame &top() noexcept { return *last; }
 
-        case '\t':
-        case '\n':
-        case '\r':
-        case ' ':
-          ++begin;
+      template<typename... Args>
+      Frame &push(Args&&... args) {
+        if (count >= InPlaceSize && (count - InPlaceSize) == blocks.size() * BlockSize) {
+          blocks.push_back(nullptr);
+          blocks.back() = Traits::allocate(allocator, BlockSize);
         }
+        Frame *frame = at(count);
+        ::new(frame) Frame(std::forward<Args>(args)...);
+        ++count;
+        return *(last = frame);
+      }
+      void pop() noexcept {
+        last->~Frame();
+        --count;
+        last = count ? at(count - 1) : nullptr;
+      }
+      void clear() noexcept {
+        while (count)
+          pop();
       }
-      return true;
-    }
-    struct ParserImplBase {
-      ParserImplBase(std::string_view input, const ParsingOptions &options) : input{ input }, options{ options },
-        surrogateReplacement{ options.replaceInvalidUtf16Surrogates ? options.replacement : ~char32_t{ 0 } },
-        i{ input.data() }, end{ input.data() + input.size() } {}
-      size_t parsedSize() const { return static_cast<size_t>(i - input.data()); }
 
-    protected:
-      bool isInputEmpty() const { return i == end; }
-      void skipDigits() {
-        while (!isInputEmpty() && isDecimalDigit(*i))
-          ++i;
+    private:
+      using Traits = std::allocator_traits<ReboundAllocator<Allocator, Frame>>;
+      static constexpr size_t InPlaceSize = 4;
+      static constexpr size_t BlockSize = 16;
+
+      Frame *at(size_t k) noexcept {
+        if (k < InPlaceSize)
+          return std::launder(reinterpret_cast<Frame*>(inPlace)) + k;
+        k -= InPlaceSize;
+        return blocks[k / BlockSize] + k % BlockSize;
       }
 
-      const std::string_view input;
-      const ParsingOptions &options;
-      const char32_t surrogateReplacement;
-      const char *i;
-      const char *const end;
+      alignas(Frame) unsigned char inPlace[InPlaceSize * sizeof(Frame)];
+      ReboundAllocator<Allocator, Frame> allocator;
+      std::vector<Frame*, ReboundAllocator<Allocator, Frame*>> blocks;
+      size_t count = 0;
+      Frame *last = nullptr;
     };
-    template<typename Allocator>
+
+    template<typename Allocator, typename Builder> // builder may be a reference to be reused by several parsers
     struct ParserImpl final : ParserImplBase {
-      using Value = BasicValue<Allocator>;
-      using String = typename Value::String;
-      using Variant = typename Value::Variant;
+      using Slot = typename std::remove_reference_t<Builder>::Slot;
 
-      ParserImpl(std::string_view input, const ParsingOptions &options, const Allocator &allocator) :
-        ParserImplBase{ input, options }, issues{ allocator }, allocator{ allocator } {}
-      bool parse(Value &v) {
-        return !detectEndOfInputAfterSkippingWhitespaces() && parseImpl(v.variant());
+      ParserImpl(std::string_view input, const ParsingOptions &options, const Allocator &allocator, Builder builder) :
+        ParserImplBase{ input, options }, issues{ allocator }, builder{ std::forward<Builder>(builder) },
+        frames{ allocator }, structuralIndex{ allocator } {}
+      ParserImpl(char *input, size_t size, const ParsingOptions &options, const Allocator &allocator, Builder builder) :
+        ParserImpl{ std::string_view{ input, size }, options, allocator, std::forward<Builder>(builder) } {
+        mutableInput = input;
+      }
+      bool parse(Slot v) {
+        if (options.engine == ParsingOptions::Engine::StructuralIndex &&
+            input.size() <= StructuralIndex<Allocator>::MaxInputSize) {
+          structuralIndex.build(input);
+          structural = structuralIndex.positions.data();
+        }
+        const bool isParsed = !detectEndOfInputAfterSkippingWhitespaces() && parseImpl(v);
+        frames.clear();
+        return isParsed;
       }
 
       std::vector<ParsingIssue, detail::ReboundAllocator<Allocator, ParsingIssue>> issues;
 
+      Builder builder;
+
     private:
-      bool parseImpl(Variant &v) {
-        switch (*i) {
-        case NullLiteral[0]: return parseLiteral<Null>(v, NullLiteral);
-        case FalseLiteral[0]: return parseLiteral<bool, false>(v, FalseLiteral);
-        case TrueLiteral[0]: return parseLiteral<bool, true>(v, TrueLiteral);
-        case '\"': return parseString(v);
-        case '[': return parseArray(v);
-        case '{': return parseObject(v);
-        default: return parseNumber(v);
+      using BuilderType = std::remove_reference_t<Builder>;
+      using ArrayBuilder = typename BuilderType::ArrayBuilder;
+      using ObjectBuilder = typename BuilderType::ObjectBuilder;
+
+      // array or object being parsed
+      struct Frame {
+        Frame(BuilderType &builder, Slot slot, const char *begin, bool isObject) :
+          slot{ slot }, begin{ begin }, isObject{ isObject } {
+          if (isObject)
+            ::new(&object) ObjectBuilder(builder.object(slot));
+          else
+            ::new(&array) ArrayBuilder(builder.array(slot));
+        }
+        ~Frame() {
+          if (isObject)
+            object.~ObjectBuilder();
+          else
+            array.~ArrayBuilder();
+        }
+
+        union {
+          ArrayBuilder array;
+          ObjectBuilder object;
+        };
+        Slot slot;
+        const char *begin;
+        bool isObject;
+      };
+
+      // containers are parsed iteratively keeping their frames on the heap, so deeply nested input can't exhaust
+      // the call stack; opening a container is followed by parsing its first member
+      bool parseImpl(Slot v) {
+        for (;;) {
+          [[maybe_unused]] const char *const begin = i;
+          switch (*i) {
+          case NullLiteral[0]:
+            if (!parseLiteral(NullLiteral))
+              return false;
+            builder.null(v);
+            break;
+          case FalseLiteral[0]:
+            if (!parseLiteral(FalseLiteral))
+              return false;
+            builder.boolean(v, false);
+            break;
+          case TrueLiteral[0]:
+            if (!parseLiteral(TrueLiteral))
+              return false;
+            builder.boolean(v, true);
+            break;
+          case '\"':
+            if (!parseString(v))
+              return false;
+            break;
+          case '[':
+          case '{': {
+            if (frames.size() == options.maxDepth) {
+              addIssue(i, "maximum nesting depth exceeded", ParsingIssue::Code::MaxDepthExceeded);
+              return false;
+            }
+            const bool isObject = *i == '{';
+            ++i; // opening '[' or '{' is matched
+            if (detectEndOfInputAfterSkippingWhitespaces())
+              return false;
+            Frame &frame = frames.push(builder, v, begin, isObject);
+            if (*i != (isObject ? '}' : ']')) {
+              if (!isObject)
+                v = builder.element(frame.array);
+              else if (!parseKey(frame.object, v))
+                return false;
+              continue;
+            }
+            ++i;
+            closeContainer();
+            break;
+          }
+          default:
+            if (!parseNumber(v))
+              return false;
+          }
+          if constexpr (LocatesValues<BuilderType>) {
+            if (*begin != '[' && *begin != '{') // containers are located when closed
+              builder.valueSpan(v, begin, i);
+          }
+
+          // value is parsed, proceeding with enclosing containers
+          for (;;) {
+            if (frames.empty())
+              return true;
+            if (detectEndOfInputAfterSkippingWhitespaces())
+              return false;
+            Frame &frame = frames.top();
+            if (*i == ',') {
+              ++i;
+              if (detectEndOfInputAfterSkippingWhitespaces())
+                return false;
+              if (!frame.isObject)
+                v = builder.element(frame.array);
+              else if (!parseKey(frame.object, v))
+                return false;
+              break;
+            }
+            if (*i != (frame.isObject ? '}' : ']')) {
+              addInvalidCharacterIssue(frame.isObject ? "invalid character, ',' or '}' expected" :
+                                                        "invalid character, ',' or ']' expected");
+              return false;
+            }
+            ++i;
+            closeContainer();
+          }
+        }
+      }
+      void closeContainer() {
+        Frame &frame = frames.top();
+        if (frame.isObject)
+          builder.endObject(frame.object);
+        else
+          builder.endArray(frame.array);
+        if constexpr (LocatesValues<BuilderType>)
+          builder.valueSpan(frame.slot, frame.begin, i);
+        frames.pop();
+      }
+      // parses key of an object member and ':' following it, sets slot of the member value
+      bool parseKey(ObjectBuilder &o, Slot &v) {
+        if (!matchCharacter('\"', "invalid character, JSON string expected"))
+          return false;
+        const char *keyBegin = i;
+        auto &&key = builder.key(o);
+        if (!parseString(key) || detectEndOfInputAfterSkippingWhitespaces() ||
+            !matchCharacter(':', "invalid character, ':' expected"))
+          return false;
+        ++i;
+        if (detectEndOfInputAfterSkippingWhitespaces())
+          return false;
+        const auto member = builder.member(o, key);
+        if (!member.isInserted && options.duplicateObjectKeys != ParsingOptions::Option::Ignore) {
+          addIssue(keyBegin, "JSON object contains duplicate keys", ParsingIssue::Code::DuplicateKeys);
+          if (options.duplicateObjectKeys == ParsingOptions::Option::Fail)
+            return false;
         }
+        v = member.value;
+        return true;
+      }
+
+      bool skipWhitespaces() {
+        if (!structural)
+          return detail::skipWhitespaces(i, end);
+        if (!isInputEmpty() && isWhitespace(*i))
+          i = input.data() + findStructural(i);
+        return isInputEmpty();
+      }
+      uint32_t findStructural(const char *p) {
+        const auto offset = static_cast<uint32_t>(p - input.data());
+        while ((*structural & ~StructuralIndex<Allocator>::DirtyStringFlag) < offset)
+          ++structural;
+        return *structural & ~StructuralIndex<Allocator>::DirtyStringFlag;
       }
 
       bool detectEndOfInputAfterSkippingWhitespaces() {
-        if (skipWhitespaces(i, end)) {
+        if (skipWhitespaces()) {
           addUnexpectedEndOfInputIssue();
           return true;
         }
@@ -1074,25 +4468,70 @@ namespace minjson {
         return detectEndOfInput();
       }
 
-      template<typename T, T... value>
-      bool parseLiteral(Variant &v, std::string_view pattern) {
+      bool parseLiteral(std::string_view pattern) {
         // first char should already be matched
         const auto [e1, e2] = std::mismatch(i + 1, end, pattern.begin() + 1, pattern.end());
         i = e1;
-        if (e2 == pattern.end()) { // pattern matched
-          v.template emplace<T>(value...);
+        if (e2 == pattern.end()) // pattern matched
           return true;
-        }
         isInputEmpty() ? addUnexpectedEndOfInputIssue() : addInvalidCharacterIssue();
         return false;
       }
 
-      bool parseString(String &s) {
+      template<typename S>
+      bool parseString(S &s) {
+        if constexpr (CanBorrowCharacters<S>) {
+          if (mutableInput)
+            return parseStringInSitu(s);
+        }
+        const char *const begin = i + 1;
+        if (!parseStringContents(s))
+          return false;
+        if (options.validation == Utf8Validation::FailOnInvalidUtf8CodeUnits) {
+          // escapes are ASCII, so raw contents are validated
+          if (const char *invalid = findInvalidUtf8CodePoint(begin, i - 1); invalid != i - 1) {
+            addInvalidUtf8Issue(invalid);
+            return false;
+          }
+        }
+        return true;
+      }
+      template<typename S>
+      bool parseStringInSitu(S &s) {
+        char *const begin = mutableInput + (i + 1 - input.data());
+        // escapes are ASCII, so validating raw contents between them is the same as validating whole raw contents
+        InSituStringWriter writer{ begin, options.validation == Utf8Validation::FailOnInvalidUtf8CodeUnits };
+        if (!parseStringContents(writer))
+          return false;
+        if (writer.invalid) {
+          addInvalidUtf8Issue(writer.invalid);
+          return false;
+        }
+        s.borrow({ begin, static_cast<size_t>(writer.out - begin) });
+        return true;
+      }
+      template<typename S>
+      bool parseStringContents(S &s) {
+        if (structural && findStructural(i) == static_cast<size_t>(i - input.data())) {
+          // closing '"' follows the opening one in the structural index,
+          // strings containing escapes or control characters are flagged and fail the check below
+          const uint32_t closing = structural[1];
+          if (closing < input.size() && input[closing] == '\"') {
+            assignPlainString(s, i + 1, input.data() + closing);
+            i = input.data() + closing + 1;
+            structural += 2;
+            return true;
+          }
+        }
         ++i; // opening '"' is already matched
+        const char *const contentsBegin = i;
         const char *pendingBegin = i;
         EscapedStringParser parser;
         Utf8Encoder encoder;
-        while (!detectEndOfInput()) {
+        for (;;) {
+          i = skipPlainStringCharacters(i, end);
+          if (detectEndOfInput())
+            return false;
           const char *const pendingEnd = i;
           auto [result, unescaped, surrogate] = parser.parseMore<UnescapeMode::Strict>(i, end);
           using ParsingResult = EscapedStringParsingResult;
@@ -1101,7 +4540,10 @@ namespace minjson {
             break;
 
           case ParsingResult::JsonStringEnd:
-            s.append(pendingBegin, i);
+            if (pendingBegin == contentsBegin)
+              assignPlainString(s, pendingBegin, i);
+            else
+              s.append(pendingBegin, i);
             ++i;
             return true;
 
@@ -1173,143 +4615,42 @@ namespace minjson {
             return false;
           }
         }
-        return false;
       }
-      bool parseString(Variant &v) {
-        return parseString(v.template emplace<String>(allocator));
+      template<typename S>
+      void assignPlainString(S &s, const char *first, const char *last) { // s is empty
+        if constexpr (CanBorrowCharacters<S>)
+          s.borrow({ first, static_cast<size_t>(last - first) });
+        else
+          s.append(first, last);
       }
-      struct InPlaceVector {
-        static constexpr size_t Capacity = 42;
-        union {
-          Value b[Capacity];
-        };
-        size_t size = 0;
-        InPlaceVector() {}
-        ~InPlaceVector() { std::destroy_n(b, size); }
-        auto &emplace_back() {
-          ::new(b + size) Value;
-          return b[size++];
-        }
-      };
-      bool parseArray(Variant &v) {
-        ++i; // opening '[' is already matched
-        if (detectEndOfInputAfterSkippingWhitespaces())
+      bool parseString(Slot v) {
+        auto &&s = builder.string(v);
+        if (!parseString(s))
           return false;
-        auto &a = v.template emplace<typename Value::Array>(allocator);
-        if (*i == ']') {
-          ++i;
-          return true;
-        }
-        return parseArrayMembers(a, InPlaceVector{});
-      }
-      template<typename... T>
-      bool parseArrayMembers(typename Value::Array &a, T... b) {
-        static_assert(sizeof...(b) <= 1);
-        for (;;) {
-          Value *v;
-          if constexpr (sizeof...(b)) {
-            v = (&b.emplace_back(), ...);
-          }
-          else {
-            v = &a.emplace_back();
-          }
-          if (!parseImpl(v->variant()) || detectEndOfInputAfterSkippingWhitespaces())
-            return false;
-          switch (*i) {
-          default:
-            addInvalidCharacterIssue("invalid character, ',' or ']' expected");
-            return false;
-
-          case ']':
-            ++i;
-            if constexpr (sizeof...(b))
-              (a.assign(std::make_move_iterator(b.b), std::make_move_iterator(b.b + b.size)), ...);
-            return true;
-
-          case ',':
-            ++i;
-            if (detectEndOfInputAfterSkippingWhitespaces())
-              return false;
-            if constexpr (sizeof...(b)) {
-              if (((b.size == b.Capacity), ...)) {
-                (a.reserve(b.size + 1), ...);
-                (a.resize(b.size), ...);
-                if (!parseArrayMembers(a))
-                  return false;
-                (std::copy_n(std::make_move_iterator(b.b), b.size, a.begin()), ...);
-                return true;
-              }
-            }
-          }
-        }
+        builder.endString(v, s);
+        return true;
       }
       bool matchCharacter(char c, std::string_view msg) {
         if (*i == c)
           return true;
-        addInvalidCharacterIssue(msg);
-        return false;
-      }
-      bool parseObject(Variant &v) {
-        ++i; // opening '{' is already matched
-        if (detectEndOfInputAfterSkippingWhitespaces())
-          return false;
-        auto &o = v.template emplace<typename Value::Object>(allocator);
-        if (*i == '}') {
-          ++i;
-          return true;
-        }
-        for (;;) {
-          if (!matchCharacter('\"', "invalid character, JSON string expected"))
-            return false;
-          const char *keyBegin = i;
-          String key{ allocator };
-          if (!parseString(key) || detectEndOfInputAfterSkippingWhitespaces() ||
-              !matchCharacter(':', "invalid character, ':' expected"))
-            return false;
-          ++i;
-          if (detectEndOfInputAfterSkippingWhitespaces())
-            return false;
-          const auto [it, isInserted] = o.try_emplace(std::move(key));
-          if (!isInserted && options.duplicateObjectKeys != ParsingOptions::Option::Ignore) {
-            addIssue(keyBegin, "JSON object contains duplicate keys", ParsingIssue::Code::DuplicateKeys);
-            if (options.duplicateObjectKeys == ParsingOptions::Option::Fail)
-              return false;
-          }
-          if (!parseImpl(it->second.variant()) || detectEndOfInputAfterSkippingWhitespaces())
-            return false;
-          switch (*i) {
-          default:
-            addInvalidCharacterIssue("invalid character, ',' or '}' expected");
-            return false;
-
-          case '}':
-            ++i;
-            return true;
-
-          case ',':
-            ++i;
-            if (detectEndOfInputAfterSkippingWhitespaces())
-              return false;
-          }
-        }
+        addInvalidCharacterIssue(msg);
+        return false;
       }
-
-      bool detectDigits() {
+      bool detectDigit() {
         if (!isDecimalDigit(*i)) {
           addInvalidCharacterIssue("invalid character, decimal digit expected");
           return false;
         }
-        ++i;
-        skipDigits();
         return true;
       }
-      bool parseNumber(Variant &v) {
+      bool parseNumber(Slot v) {
         using namespace std::string_view_literals;
         const char *const begin = i;
         // detecting integer part
         const size_t isNegative = *i == '-' ? 1 : 0;
         if (isNegative && advanceAndDetectEndOfInput())
           return false;
+        uint64_t significand = 0; // digits of integer and fraction parts, wraps around after 19 digits
         switch (*i) {
         case '0':
           ++i;
@@ -1324,43 +4665,62 @@ namespace minjson {
         case '7':
         case '8':
         case '9':
-          ++i;
-          skipDigits();
+          i = parseDecimalDigits(i, end, significand);
           break;
 
         default:
           addInvalidCharacterIssue();
           return false;
         }
+        const size_t integerDigits = static_cast<size_t>(i - begin) - isNegative;
+        size_t fractionDigits = 0;
         bool isDecimal = false;
         // detecting fraction part
         if (!isInputEmpty() && *i == '.') {
-          if (advanceAndDetectEndOfInput() || !detectDigits()) // should be at least one digit after decimal point
+          if (advanceAndDetectEndOfInput() || !detectDigit()) // should be at least one digit after decimal point
             return false;
+          const char *const fractionBegin = i;
+          i = parseDecimalDigits(i, end, significand);
+          fractionDigits = static_cast<size_t>(i - fractionBegin);
           isDecimal = true;
         }
         // detecting exponent part
+        int64_t exponent = 0;
         if (!isInputEmpty() && (*i | '\x20') == 'e') {
-          if (advanceAndDetectEndOfInput() ||
-              (*i == '+' || *i == '-') && advanceAndDetectEndOfInput() ||
-              !detectDigits())
+          if (advanceAndDetectEndOfInput())
+            return false;
+          const bool isExponentNegative = *i == '-';
+          if ((*i == '+' || *i == '-') && advanceAndDetectEndOfInput() || !detectDigit())
             return false;
+          for (; !isInputEmpty() && isDecimalDigit(*i); ++i)
+            if (exponent < 1000000) // saturating, the value is out of range long before that anyway
+              exponent = exponent * 10 + (*i - '0');
+          if (isExponentNegative)
+            exponent = -exponent;
           isDecimal = true;
         }
-        if (!isDecimal) {
-          const size_t length = i - begin - isNegative;
-          constexpr std::string_view maxValue[] = { "9223372036854775807"sv, "9223372036854775808"sv };
-          if (length < 19 || length == 19 && std::string_view{ begin + isNegative, 19 } <= maxValue[isNegative]) {
-            int64_t integer;
-            const auto result = std::from_chars(begin, i, integer);
-            if (result.ec != std::errc{}) {
-              addIssue(result.ptr, "failed to parse number value"sv, ParsingIssue::Code::FailedToParseNumber);
-              return false;
-            }
-            v.template emplace<int64_t>(integer);
+        // 19 digits always fit into uint64_t, the magnitude of the minimum int64_t value is greater by 1 than the maximum
+        if (!isDecimal && integerDigits <= 19 &&
+            significand <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + isNegative) {
+          builder.integer(v, static_cast<int64_t>(isNegative ? 0 - significand : significand));
+          return true;
+        }
+        size_t significantDigits = integerDigits + fractionDigits;
+        if (significantDigits > 19) // leading zeros don't count
+          for (const char *p = begin + isNegative; p != i && (*p == '0' || *p == '.'); ++p)
+            significantDigits -= *p == '0';
+        if (significantDigits <= 19) {
+          if (significand == 0) {
+            builder.decimal(v, isNegative ? -0.0 : 0.0);
+            return true;
+          }
+          const int64_t decimalExponent = exponent - static_cast<int64_t>(fractionDigits);
+          if (double decimal; decimalToDouble(significand, decimalExponent, isNegative != 0, decimal)) {
+            builder.decimal(v, decimal);
             return true;
           }
         }
+        // rare cases: more than 19 significant digits, subnormal and out of range values
         double decimal;
 #if !defined(_LIBCPP_VERSION) || _LIBCPP_VERSION >= 200100
         const auto result = std::from_chars(begin, i, decimal);
@@ -1391,7 +4751,7 @@ namespace minjson {
           return false;
         }
 #endif
-        v.template emplace<double>(decimal);
+        builder.decimal(v, decimal);
         return true;
       }
 
@@ -1404,7 +4764,12 @@ namespace minjson {
       void addInvalidCharacterIssue(std::string_view msg = "invalid character") {
         addIssue(i, msg, ParsingIssue::Code::InvalidCharacter);
       }
-      bool checkInvalidUtf16SurrogateOptionAndEncode(String &s, uint32_t surrogate,
+      void addInvalidUtf8Issue(const char *p) {
+        i = p;
+        addIssue(i, "string contains invalid UTF-8 code units", ParsingIssue::Code::StringContainsInvalidUtf8CodeUnits);
+      }
+      template<typename S>
+      bool checkInvalidUtf16SurrogateOptionAndEncode(S &s, uint32_t surrogate,
                                                      const char *p,
                                                      std::string_view description,
                                                      ParsingIssue::Code code) {
@@ -1416,18 +4781,23 @@ namespace minjson {
         s += Utf8Encoder{}.encodeSurrogateCodeUnitAsCodePoint(surrogate, surrogateReplacement);
         return true;
       }
-      bool checkInvalidUtf16HighSurrogateOptionAndEncode(String &s, uint32_t surrogate, const char *p) {
+      template<typename S>
+      bool checkInvalidUtf16HighSurrogateOptionAndEncode(S &s, uint32_t surrogate, const char *p) {
         return checkInvalidUtf16SurrogateOptionAndEncode(s, surrogate,
                                                          p, "string contains unpaired UTF-16 high surrogate",
                                                          ParsingIssue::Code::StringContainsUnpairedUtf16HighSurrogate);
       }
-      bool checkInvalidUtf16LowSurrogateOptionAndEncode(String &s, uint32_t surrogate, const char *p) {
+      template<typename S>
+      bool checkInvalidUtf16LowSurrogateOptionAndEncode(S &s, uint32_t surrogate, const char *p) {
         return checkInvalidUtf16SurrogateOptionAndEncode(s, surrogate,
                                                          p, "string contains unpaired UTF-16 low surrogate",
                                                          ParsingIssue::Code::StringContainsUnpairedUtf16LowSurrogate);
       }
 
-      Allocator allocator;
+      FrameStack<Frame, Allocator> frames;
+      StructuralIndex<Allocator> structuralIndex;
+      const uint32_t *structural = nullptr;
+      char *mutableInput = nullptr; // same as input, set for in situ parsing
     };
   }
 
@@ -1436,26 +4806,205 @@ namespace minjson {
     Success,
     PartialSuccess
   };
-  template<typename Allocator>
+  template<typename Allocator, typename Policy = DefaultValuePolicy>
   struct BasicParsingResult {
     using Status = ParsingResultStatus;
     using Issues = std::vector<ParsingIssue, detail::ReboundAllocator<Allocator, ParsingIssue>>;
 
-    BasicValue<Allocator> value;
+    BasicValue<Allocator, Policy> value;
     Status status;
     size_t parsedSize;
     Issues issues;
   };
   using ParsingResult = BasicParsingResult<std::allocator<char>>;
+  using ZeroCopyParsingResult = BasicParsingResult<std::allocator<char>, ZeroCopyValuePolicy>;
+
+  template<typename Allocator>
+  struct BasicDocumentParsingResult {
+    using Status = ParsingResultStatus;
+    using Issues = std::vector<ParsingIssue, detail::ReboundAllocator<Allocator, ParsingIssue>>;
+
+    BasicDocument<Allocator> document;
+    Status status;
+    size_t parsedSize;
+    Issues issues;
+  };
+  using DocumentParsingResult = BasicDocumentParsingResult<std::allocator<char>>;
+
+  // parsed value together with minjson::Arena its memory is allocated from;
+  // destruction frees chunks of the arena without destroying nested values one by one
+  template<typename Policy = DefaultValuePolicy>
+  struct BasicArenaDocument {
+    using Value = BasicValue<ArenaAllocator<char>, Policy>;
+
+    explicit BasicArenaDocument(Arena &&arena) :
+      m_arena{ std::make_unique<Arena>(std::move(arena)) },
+      m_value{ ::new(m_arena->allocate(sizeof(Value), alignof(Value))) Value{} } {}
+
+    [[nodiscard]] const Value &value() const noexcept { return *m_value; }
+    [[nodiscard]] Value &value() noexcept { return *m_value; }
+    [[nodiscard]] Arena &arena() const noexcept { return *m_arena; }
+    [[nodiscard]] ArenaAllocator<char> allocator() const noexcept { return *m_arena; }
+
+  private:
+    std::unique_ptr<Arena> m_arena; // has stable address referred to by allocators of nested values
+    Value *m_value; // allocated from the arena and never destroyed
+  };
+  using ArenaDocument = BasicArenaDocument<>;
+
+  template<typename Policy = DefaultValuePolicy>
+  struct BasicArenaParsingResult {
+    using Status = ParsingResultStatus;
+    using Issues = std::vector<ParsingIssue>; // not allocated from the arena so they may outlive the document
+
+    BasicArenaDocument<Policy> document;
+    Status status;
+    size_t parsedSize;
+    Issues issues;
+  };
+  using ArenaParsingResult = BasicArenaParsingResult<>;
+
+  template<typename Allocator>
+  struct BasicSaxParsingResult {
+    using Status = ParsingResultStatus;
+    using Issues = std::vector<ParsingIssue, detail::ReboundAllocator<Allocator, ParsingIssue>>;
+
+    Status status;
+    size_t parsedSize;
+    Issues issues;
+  };
+  using SaxParsingResult = BasicSaxParsingResult<std::allocator<char>>;
+
+  namespace detail {
+    template<typename Allocator, typename Policy>
+    using ValueParserImpl = ParserImpl<Allocator, ValueBuilder<Allocator, Policy>>;
+
+    template<typename Allocator, typename Policy>
+    BasicParsingResult<Allocator, Policy> parse(ValueParserImpl<Allocator, Policy> &parser, const Allocator &allocator) {
+      using Result = BasicParsingResult<Allocator, Policy>;
+      Result result{ {}, {}, {}, typename Result::Issues{ allocator } };
+      result.status =
+        parser.parse(&result.value.variant()) ? ParsingResultStatus::Success : ParsingResultStatus::Failure;
+      result.issues = std::move(parser.issues);
+      result.parsedSize = parser.parsedSize();
+      return result;
+    }
+  }
+
+  namespace impl {
+    template<typename Allocator, typename Policy = DefaultValuePolicy>
+    [[nodiscard]] BasicParsingResult<Allocator, Policy> parse(std::string_view input,
+                                                              const ParsingOptions &options,
+                                                              const Allocator &allocator) {
+      detail::ValueParserImpl<Allocator, Policy> parser{
+        input, options, allocator, { allocator, { options.keyDictionary } } };
+      return detail::parse(parser, allocator);
+    }
+
+    template<typename Allocator>
+    [[nodiscard]] BasicParsingResult<Allocator, ZeroCopyValuePolicy>
+      parseInSitu(char *input, size_t size, const ParsingOptions &options, const Allocator &allocator) {
+      detail::ValueParserImpl<Allocator, ZeroCopyValuePolicy> parser{
+        input, size, options, allocator, { allocator, { options.keyDictionary } } };
+      return detail::parse(parser, allocator);
+    }
+
+    template<typename Allocator>
+    [[nodiscard]] BasicDocumentParsingResult<Allocator> parseDocument(std::string_view input,
+                                                                      const ParsingOptions &options,
+                                                                      const Allocator &allocator) {
+      using Result = BasicDocumentParsingResult<Allocator>;
+      Result result{ BasicDocument<Allocator>{ allocator }, {}, {}, typename Result::Issues{ allocator } };
+      detail::ParserImpl<Allocator, detail::TapeBuilder<Allocator>> parser{
+        input, options, allocator, detail::TapeBuilder<Allocator>{ result.document } };
+      if (parser.parse({})) {
+        result.status = ParsingResultStatus::Success;
+      }
+      else {
+        result.status = ParsingResultStatus::Failure;
+        parser.builder.discard(); // incomplete tape can't be navigated
+      }
+      result.issues = std::move(parser.issues);
+      result.parsedSize = parser.parsedSize();
+      return result;
+    }
+
+    template<typename Allocator, typename Handler>
+    [[nodiscard]] BasicSaxParsingResult<Allocator> parseSax(std::string_view input,
+                                                            Handler &handler,
+                                                            const ParsingOptions &options,
+                                                            const Allocator &allocator) {
+      using Result = BasicSaxParsingResult<Allocator>;
+      using Builder = detail::SaxBuilder<Allocator, Handler>;
+      detail::ParserImpl<Allocator, Builder> parser{
+        input, options, allocator,
+        Builder{ handler, options.duplicateObjectKeys != ParsingOptions::Option::Ignore, allocator } };
+      Result result{ {}, {}, typename Result::Issues{ allocator } };
+      result.status = parser.parse({}) ? ParsingResultStatus::Success : ParsingResultStatus::Failure;
+      result.issues = std::move(parser.issues);
+      result.parsedSize = parser.parsedSize();
+      return result;
+    }
+  }
+
+  template<typename Allocator>
+  struct BasicExtractionResult {
+    using Status = ParsingResultStatus;
+    using Issues = std::vector<ParsingIssue, detail::ReboundAllocator<Allocator, ParsingIssue>>;
+    using Values = std::vector<std::string_view, detail::ReboundAllocator<Allocator, std::string_view>>;
+
+    Values values; // in the order of pointers, empty if not found
+    Status status;
+    size_t parsedSize;
+    Issues issues;
+  };
+  using ExtractionResult = BasicExtractionResult<std::allocator<char>>;
 
   namespace impl {
     template<typename Allocator>
-    [[nodiscard]] BasicParsingResult<Allocator> parse(std::string_view input,
-                                                      const ParsingOptions &options,
-                                                      const Allocator &allocator) {
-      detail::ParserImpl<Allocator> parser{ input, options, allocator };
-      BasicParsingResult<Allocator> result{ {}, {}, {}, typename BasicParsingResult<Allocator>::Issues{ allocator } };
-      result.status = parser.parse(result.value) ? ParsingResultStatus::Success : ParsingResultStatus::Failure;
+    [[nodiscard]] BasicExtractionResult<Allocator> extract(std::string_view input,
+                                                           const BasicJsonPointerSet<Allocator> &pointers,
+                                                           const ParsingOptions &options,
+                                                           const Allocator &allocator) {
+      using Result = BasicExtractionResult<Allocator>;
+      using Builder = detail::JsonPointerSetBuilder<Allocator>;
+      Result result{ typename Result::Values(pointers.size(), allocator), {}, {}, typename Result::Issues{ allocator } };
+      detail::ParserImpl<Allocator, Builder> parser{
+        input,
+        options,
+        allocator,
+        Builder{ pointers,
+                 result.values.data(),
+                 typename Builder::Buffer{ allocator },
+                 { options.duplicateObjectKeys != ParsingOptions::Option::Ignore, allocator } } };
+      result.status = parser.parse(0) ? ParsingResultStatus::Success : ParsingResultStatus::Failure;
+      parser.builder.copyDuplicates();
+      result.issues = std::move(parser.issues);
+      result.parsedSize = parser.parsedSize();
+      return result;
+    }
+  }
+
+  namespace impl {
+    template<typename Allocator, typename Policy = DefaultValuePolicy>
+    [[nodiscard]] BasicParsingResult<Allocator, Policy> parseProjected(std::string_view input,
+                                                                       const BasicJsonPointerSet<Allocator> &projection,
+                                                                       const ParsingOptions &options,
+                                                                       const Allocator &allocator) {
+      using Result = BasicParsingResult<Allocator, Policy>;
+      using Builder = detail::ProjectingValueBuilder<Allocator, Policy>;
+      Result result{ {}, {}, {}, typename Result::Issues{ allocator } };
+      detail::ParserImpl<Allocator, Builder> parser{
+        input,
+        options,
+        allocator,
+        Builder{ projection,
+                 allocator,
+                 typename Builder::String{ allocator },
+                 { options.keyDictionary },
+                 { options.duplicateObjectKeys != ParsingOptions::Option::Ignore, allocator } } };
+      result.status = parser.parse(parser.builder.root(result.value.variant())) ? ParsingResultStatus::Success
+                                                                                : ParsingResultStatus::Failure;
       result.issues = std::move(parser.issues);
       result.parsedSize = parser.parsedSize();
       return result;
@@ -1467,28 +5016,670 @@ namespace minjson {
     StopAfterValueEnds
   };
 
-  template<typename Allocator = std::allocator<char>>
-  [[nodiscard]] BasicParsingResult<Allocator> parse(std::string_view input,
-                                                    const ParsingOptions &options = {},
-                                                    ParsingMode parsingMode = ParsingMode::VerifyTrailingWhitespace,
-                                                    const Allocator &allocator = {}) {
-    BasicParsingResult<Allocator> result = impl::parse<Allocator>(input, options, allocator);
-    if (result.status == ParsingResultStatus::Success && parsingMode == ParsingMode::VerifyTrailingWhitespace) {
+  namespace detail {
+    template<typename Result>
+    void verifyTrailingWhitespace(Result &result, std::string_view input) {
+      if (result.status != ParsingResultStatus::Success)
+        return;
       const char *begin = input.data() + result.parsedSize;
-      const bool reachedEnd = detail::skipWhitespaces(begin, input.data() + input.size());
+      const bool reachedEnd = skipWhitespaces(begin, input.data() + input.size());
       result.parsedSize = static_cast<size_t>(begin - input.data());
       if (!reachedEnd) {
         result.status = ParsingResultStatus::PartialSuccess;
         result.issues.push_back({ result.parsedSize, "non-whitespace characters after a valid JSON value" });
       }
     }
+  }
+
+  template<typename Allocator = std::allocator<char>, typename Policy = DefaultValuePolicy>
+  [[nodiscard]] BasicParsingResult<Allocator, Policy> parse(std::string_view input,
+                                                            const ParsingOptions &options = {},
+                                                            ParsingMode parsingMode = ParsingMode::VerifyTrailingWhitespace,
+                                                            const Allocator &allocator = {}) {
+    BasicParsingResult<Allocator, Policy> result = impl::parse<Allocator, Policy>(input, options, allocator);
+    if (parsingMode == ParsingMode::VerifyTrailingWhitespace)
+      detail::verifyTrailingWhitespace(result, input);
+    return result;
+  }
+
+  // the arena is moved into the resulting document which owns the parsed value
+  template<typename Policy = DefaultValuePolicy, typename A, std::enable_if_t<std::is_same_v<A, Arena>, int> = 0>
+  [[nodiscard]] BasicArenaParsingResult<Policy> parse(std::string_view input,
+                                                      A &&arena,
+                                                      const ParsingOptions &options = {},
+                                                      ParsingMode parsingMode = ParsingMode::VerifyTrailingWhitespace) {
+    BasicArenaDocument<Policy> document{ std::move(arena) };
+    auto [value, status, parsedSize, issues] =
+      impl::parse<ArenaAllocator<char>, Policy>(input, options, document.allocator());
+    document.value() = std::move(value);
+    BasicArenaParsingResult<Policy> result{ std::move(document), status, parsedSize, { issues.begin(), issues.end() } };
+    if (parsingMode == ParsingMode::VerifyTrailingWhitespace)
+      detail::verifyTrailingWhitespace(result, input);
+    return result;
+  }
+
+  // strings of the result may refer to characters of the input, so the input must outlive the result
+  [[nodiscard]] inline ZeroCopyParsingResult parseZeroCopy(std::string_view input,
+                                                           const ParsingOptions &options = {},
+                                                           ParsingMode parsingMode = ParsingMode::VerifyTrailingWhitespace) {
+    return parse<std::allocator<char>, ZeroCopyValuePolicy>(input, options, parsingMode);
+  }
+
+  // contents of the input are overwritten, strings of the result refer to characters of the input,
+  // so the input must outlive the result
+  template<typename Allocator = std::allocator<char>>
+  [[nodiscard]] BasicParsingResult<Allocator, ZeroCopyValuePolicy>
+    parseInSitu(char *input,
+                size_t size,
+                const ParsingOptions &options = {},
+                ParsingMode parsingMode = ParsingMode::VerifyTrailingWhitespace,
+                const Allocator &allocator = {}) {
+    BasicParsingResult<Allocator, ZeroCopyValuePolicy> result = impl::parseInSitu(input, size, options, allocator);
+    if (parsingMode == ParsingMode::VerifyTrailingWhitespace)
+      detail::verifyTrailingWhitespace(result, { input, size });
+    return result;
+  }
+
+  template<typename Allocator = std::allocator<char>>
+  [[nodiscard]] BasicDocumentParsingResult<Allocator>
+    parseDocument(std::string_view input,
+                  const ParsingOptions &options = {},
+                  ParsingMode parsingMode = ParsingMode::VerifyTrailingWhitespace,
+                  const Allocator &allocator = {}) {
+    BasicDocumentParsingResult<Allocator> result = impl::parseDocument(input, options, allocator);
+    if (parsingMode == ParsingMode::VerifyTrailingWhitespace)
+      detail::verifyTrailingWhitespace(result, input);
+    return result;
+  }
+
+  // read-only contents of a file, memory mapped on POSIX systems, read into memory otherwise
+  struct MappedFile {
+    explicit MappedFile(const std::filesystem::path &path) {
+#if defined(MINJSONCPP_MMAP)
+      const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd == -1)
+        throwError(errno, "failed to open ", path);
+      struct stat status;
+      if (::fstat(fd, &status) == -1) {
+        const int error = errno;
+        ::close(fd);
+        throwError(error, "failed to get size of ", path);
+      }
+      m_size = static_cast<size_t>(status.st_size);
+      if (m_size != 0) { // empty files can't be mapped
+        void *mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        const int error = errno;
+        ::close(fd); // mapping stays valid
+        if (mapping == MAP_FAILED)
+          throwError(error, "failed to map ", path);
+        ::madvise(mapping, m_size, MADV_SEQUENTIAL); // parser reads the input once from the beginning to the end
+        m_data = static_cast<const char*>(mapping);
+      }
+      else {
+        ::close(fd);
+      }
+#else
+      std::ifstream file{ path, std::ios_base::binary | std::ios_base::ate };
+      if (!file.is_open())
+        throwError(static_cast<int>(std::errc::no_such_file_or_directory), "failed to open ", path);
+      m_size = static_cast<size_t>(file.tellg());
+      m_buffer.reset(new char[m_size]);
+      if (!file.seekg(0).read(m_buffer.get(), static_cast<std::streamsize>(m_size)))
+        throwError(static_cast<int>(std::errc::io_error), "failed to read ", path);
+      m_data = m_buffer.get();
+#endif
+    }
+    MappedFile(MappedFile &&other) noexcept { swap(other); }
+    MappedFile &operator=(MappedFile &&other) noexcept {
+      MappedFile{ std::move(other) }.swap(*this);
+      return *this;
+    }
+    ~MappedFile() {
+#if defined(MINJSONCPP_MMAP)
+      if (m_data)
+        ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+    }
+
+    [[nodiscard]] const char *data() const noexcept { return m_data; }
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] std::string_view view() const noexcept { return { m_data, m_size }; }
+    operator std::string_view() const noexcept { return view(); }
+
+    void swap(MappedFile &other) noexcept {
+      std::swap(m_data, other.m_data);
+      std::swap(m_size, other.m_size);
+#if !defined(MINJSONCPP_MMAP)
+      std::swap(m_buffer, other.m_buffer);
+#endif
+    }
+
+  private:
+    [[noreturn]] static void throwError(int error, const char *what, const std::filesystem::path &path) {
+      throw std::system_error{ error, std::generic_category(), what + path.string() };
+    }
+
+    const char *m_data = nullptr;
+    size_t m_size = 0;
+#if !defined(MINJSONCPP_MMAP)
+    std::unique_ptr<char[]> m_buffer;
+#endif
+  };
+
+  // parses contents of the file directly from its memory mapping (see minjson::MappedFile),
+  // throws std::system_error if the file can't be read
+  template<typename Allocator = std::allocator<char>, typename Policy = DefaultValuePolicy>
+  [[nodiscard]] BasicParsingResult<Allocator, Policy> parseFile(const std::filesystem::path &path,
+                                                                const ParsingOptions &options = {},
+                                                                ParsingMode parsingMode = ParsingMode::VerifyTrailingWhitespace,
+                                                                const Allocator &allocator = {}) {
+    static_assert(!detail::CanBorrowCharacters<typename BasicValue<Allocator, Policy>::String>,
+                  "strings would refer to the file which is unmapped on return, "
+                  "use minjson::MappedFile with minjson::parse() instead");
+    const MappedFile file{ path };
+    return parse<Allocator, Policy>(file.view(), options, parsingMode, allocator);
+  }
+
+  template<typename Allocator = std::allocator<char>>
+  [[nodiscard]] BasicDocumentParsingResult<Allocator>
+    parseDocumentFile(const std::filesystem::path &path,
+                      const ParsingOptions &options = {},
+                      ParsingMode parsingMode = ParsingMode::VerifyTrailingWhitespace,
+                      const Allocator &allocator = {}) {
+    const MappedFile file{ path };
+    return parseDocument(file.view(), options, parsingMode, allocator);
+  }
+
+  // handler receives events as values are parsed, so it receives events preceding an error if parsing fails;
+  // strings passed to the handler are valid only during the call
+  template<typename Handler, typename Allocator = std::allocator<char>>
+  [[nodiscard]] BasicSaxParsingResult<Allocator>
+    parseSax(std::string_view input,
+             Handler &handler,
+             const ParsingOptions &options = {},
+             ParsingMode parsingMode = ParsingMode::VerifyTrailingWhitespace,
+             const Allocator &allocator = {}) {
+    BasicSaxParsingResult<Allocator> result = impl::parseSax(input, handler, options, allocator);
+    if (parsingMode == ParsingMode::VerifyTrailingWhitespace)
+      detail::verifyTrailingWhitespace(result, input);
     return result;
   }
+
+  // builds only values designated by JSON Pointers of the projection and containers leading to them,
+  // other values are validated but not stored
+  template<typename Allocator = std::allocator<char>, typename Policy = DefaultValuePolicy>
+  [[nodiscard]] BasicParsingResult<Allocator, Policy>
+    parseProjected(std::string_view input,
+                   const BasicJsonPointerSet<Allocator> &projection,
+                   const ParsingOptions &options = {},
+                   ParsingMode parsingMode = ParsingMode::VerifyTrailingWhitespace,
+                   const Allocator &allocator = {}) {
+    BasicParsingResult<Allocator, Policy> result =
+      impl::parseProjected<Allocator, Policy>(input, projection, options, allocator);
+    if (parsingMode == ParsingMode::VerifyTrailingWhitespace)
+      detail::verifyTrailingWhitespace(result, input);
+    return result;
+  }
+
+  // extracts raw JSON text of values designated by the pointers in a single pass over the input,
+  // other values are validated but not stored; the input must outlive the result
+  template<typename Allocator = std::allocator<char>>
+  [[nodiscard]] BasicExtractionResult<Allocator>
+    extract(std::string_view input,
+            const BasicJsonPointerSet<Allocator> &pointers,
+            const ParsingOptions &options = {},
+            ParsingMode parsingMode = ParsingMode::VerifyTrailingWhitespace,
+            const Allocator &allocator = {}) {
+    BasicExtractionResult<Allocator> result = impl::extract(input, pointers, options, allocator);
+    if (parsingMode == ParsingMode::VerifyTrailingWhitespace)
+      detail::verifyTrailingWhitespace(result, input);
+    return result;
+  }
+
+  // SAX handler building a value, e.g. for minjson::BasicStreamingParser
+  template<typename Allocator = std::allocator<char>, typename Policy = DefaultValuePolicy>
+  struct BasicValueHandler {
+    using Value = BasicValue<Allocator, Policy>;
+    using Variant = typename Value::Variant;
+
+    explicit BasicValueHandler(const Allocator &allocator = {}) : allocator{ allocator }, containers{ allocator } {}
+
+    void null() { slot().template emplace<Null>(); }
+    void boolean(bool b) { slot().template emplace<bool>(b); }
+    void integer(int64_t i) { slot().template emplace<int64_t>(i); }
+    void decimal(double d) { slot().template emplace<double>(d); }
+    void string(std::string_view s) { makeString(slot().template emplace<typename Value::String>(allocator), s); }
+    void startArray() { open<typename Value::Array>(); }
+    void endArray() { containers.pop_back(); }
+    void startObject() { open<typename Value::Object>(); }
+    void key(std::string_view k) {
+      typename Value::Object::key_type key{ allocator };
+      makeString(key, k);
+      // the same as parse(), value of a duplicate key replaces the previous one
+      auto &object = std::get<typename Value::Object>(*containers.back());
+      member = &detail::tryEmplaceMember(object, std::move(key)).first->second.variant();
+    }
+    void endObject() {
+      detail::sortMembers(std::get<typename Value::Object>(*containers.back()));
+      containers.pop_back();
+    }
+
+    Value value;
+
+  private:
+    Variant &slot() {
+      if (containers.empty())
+        return value.variant();
+      if (auto *array = std::get_if<typename Value::Array>(containers.back()))
+        return array->emplace_back().variant();
+      return *member;
+    }
+    template<typename Container>
+    void open() {
+      // enclosing containers are not modified while a container is open, so pointers to it stay valid
+      Variant &v = slot();
+      v.template emplace<Container>(allocator);
+      containers.push_back(&v);
+    }
+    template<typename S>
+    static void makeString(S &s, std::string_view chars) {
+      s.append(chars.data(), chars.data() + chars.size());
+    }
+
+    Allocator allocator;
+    std::vector<Variant*, detail::ReboundAllocator<Allocator, Variant*>> containers;
+    Variant *member = nullptr;
+  };
+  using ValueHandler = BasicValueHandler<>;
+
+  // push parser accepting input in chunks, handler receives events as values are parsed (see parseSax());
+  // containers are tracked in an explicit stack, only the incomplete token at the end of a chunk is buffered
+  template<typename Handler, typename Allocator = std::allocator<char>>
+  struct BasicStreamingParser {
+    using Result = BasicSaxParsingResult<Allocator>;
+
+    explicit BasicStreamingParser(Handler &handler, const ParsingOptions &options = {}, const Allocator &allocator = {}) :
+      handler{ handler }, options{ options }, allocator{ allocator }, issues{ allocator },
+      scalarBuilder{ scalarHandler, false, allocator }, containers{ allocator },
+      pending{ allocator }, keyStrings{ allocator }, keys{ allocator } {
+      this->options.engine = ParsingOptions::Engine::Default; // tokens are too short to benefit from structural index
+    }
+    BasicStreamingParser(const BasicStreamingParser&) = delete;
+    BasicStreamingParser &operator=(const BasicStreamingParser&) = delete;
+
+    // returns false if parsing has failed or the value is followed by non-whitespace characters,
+    // further input is ignored then
+    bool feed(std::string_view chunk) {
+      if (isActive())
+        consume(chunk.data(), chunk.data() + chunk.size(), inputSize);
+      inputSize += chunk.size();
+      return isActive();
+    }
+    // ends the input, the parser should not be used afterwards
+    [[nodiscard]] Result finish(ParsingMode parsingMode = ParsingMode::VerifyTrailingWhitespace) {
+      if (isActive() && token != Token::None) { // the token ends with the input
+        isKey = token == Token::Key;
+        token = Token::None;
+        size_t parsedSize;
+        if (parseToken(pending, parsedSize) && !isKey) { // key can't be followed by the end of input
+          const size_t tokenEnd = tokenOffset + parsedSize;
+          valueEnded(tokenEnd);
+          consume(pending.data() + parsedSize, pending.data() + pending.size(), tokenEnd);
+        }
+      }
+      if (isActive() && state != State::Done) {
+        issues.push_back({ inputSize, "unexpected end of input", ParsingIssue::Code::UnexpectedEndOfInput });
+        fail(inputSize);
+      }
+
+      Result result{ ParsingResultStatus::Success, inputSize, std::move(issues) };
+      if (state == State::Failed) {
+        result.status = ParsingResultStatus::Failure;
+        result.parsedSize = failureOffset;
+      }
+      else if (parsingMode == ParsingMode::StopAfterValueEnds) {
+        result.parsedSize = valueEndOffset;
+      }
+      else if (state == State::Stopped) {
+        result.status = ParsingResultStatus::PartialSuccess;
+        result.parsedSize = garbageOffset;
+        result.issues.push_back({ garbageOffset, "non-whitespace characters after a valid JSON value" });
+      }
+      return result;
+    }
+
+  private:
+    enum class State {
+      Value,
+      ArrayValueOrEnd,
+      ArrayCommaOrEnd,
+      ObjectKeyOrEnd,
+      ObjectKey,
+      ObjectColon,
+      MemberValue, // key is passed to the handler when the value begins
+      ObjectCommaOrEnd,
+      Done,
+      Stopped, // non-whitespace characters after the value
+      Failed
+    };
+    enum class Token {
+      None,
+      String,
+      Key,
+      Other // number, literal or invalid characters
+    };
+    using Keys = detail::DuplicateKeyDetector<Allocator>;
+    struct Container {
+      bool isObject;
+      typename Keys::ObjectKeys keys;
+      size_t keyStringsSize;
+    };
+
+    // scalar tokens are parsed by the regular parser, it passes their values here
+    struct ScalarHandler {
+      void null() { parser.handler.null(); }
+      void boolean(bool b) { parser.handler.boolean(b); }
+      void integer(int64_t i) { parser.handler.integer(i); }
+      void decimal(double d) { parser.handler.decimal(d); }
+      void string(std::string_view s) {
+        if (parser.isKey)
+          parser.keyStrings.insert(parser.keyStrings.end(), s.begin(), s.end());
+        else
+          parser.handler.string(s);
+      }
+      // scalar tokens never contain containers
+      void startArray() {}
+      void endArray() {}
+      void startObject() {}
+      void key(std::string_view) {}
+      void endObject() {}
+
+      BasicStreamingParser &parser;
+    };
+    using ScalarBuilder = detail::SaxBuilder<Allocator, ScalarHandler>;
+
+    bool isActive() const { return state != State::Failed && state != State::Stopped; }
+    static bool isTokenCharacter(char c) {
+      return detail::isDecimalDigit(c) || ((c | '\x20') >= 'a' && (c | '\x20') <= 'z') || c == '-' || c == '+' || c == '.';
+    }
+
+    void consume(const char *const begin, const char *const end, const size_t offset) {
+      const char *p = begin;
+      const auto offsetOf = [begin, offset](const char *p) { return offset + static_cast<size_t>(p - begin); };
+      while (isActive()) {
+        if (token != Token::None) {
+          const char *tokenBegin = pending.empty() ? tokenPointer : begin;
+          if (!scanToken(p, end)) {
+            pending.append(tokenBegin, end);
+            return;
+          }
+          std::string_view text{ tokenBegin, static_cast<size_t>(p - tokenBegin) };
+          if (!pending.empty()) {
+            pending.append(tokenBegin, p);
+            text = pending;
+          }
+          isKey = token == Token::Key;
+          token = Token::None;
+          size_t parsedSize;
+          if (!parseToken(text, parsedSize))
+            return;
+          const size_t tokenEnd = tokenOffset + parsedSize;
+          if (isKey)
+            state = State::ObjectColon;
+          else
+            valueEnded(tokenEnd);
+          if (tokenEnd < offset) {
+            // rest of the token can't start another one, so pending is not changed while it is consumed
+            consume(pending.data() + parsedSize, pending.data() + (offset - tokenOffset), tokenEnd);
+            p = begin;
+          }
+          else {
+            p = begin + (tokenEnd - offset);
+          }
+          pending.clear();
+          continue;
+        }
+
+        if (detail::skipWhitespaces(p, end))
+          return;
+        switch (state) {
+        case State::Done:
+          garbageOffset = offsetOf(p);
+          state = State::Stopped;
+          return;
+
+        case State::MemberValue:
+          if (!emitKey(offsetOf(p)))
+            return;
+          [[fallthrough]];
+        case State::Value:
+        case State::ArrayValueOrEnd:
+          switch (*p) {
+          case ']':
+            if (state != State::ArrayValueOrEnd)
+              goto OtherToken;
+            ++p;
+            closeContainer(offsetOf(p));
+            break;
+          case '[':
+            if (!checkDepth(offsetOf(p)))
+              return;
+            ++p;
+            handler.startArray();
+            containers.push_back({ false, {}, 0 });
+            state = State::ArrayValueOrEnd;
+            break;
+          case '{':
+            if (!checkDepth(offsetOf(p)))
+              return;
+            ++p;
+            handler.startObject();
+            containers.push_back({ true, keys.object(), keyStrings.size() });
+            state = State::ObjectKeyOrEnd;
+            break;
+          case '\"':
+            startToken(Token::String, p, offsetOf(p));
+            ++p;
+            break;
+          default:
+          OtherToken:
+            startToken(Token::Other, p, offsetOf(p));
+          }
+          break;
+
+        case State::ObjectKeyOrEnd:
+          if (*p == '}') {
+            ++p;
+            closeContainer(offsetOf(p));
+            break;
+          }
+          [[fallthrough]];
+        case State::ObjectKey:
+          if (*p != '\"')
+            return failWithInvalidCharacter(offsetOf(p), "invalid character, JSON string expected");
+          startToken(Token::Key, p, offsetOf(p));
+          ++p;
+          break;
+
+        case State::ObjectColon:
+          if (*p != ':')
+            return failWithInvalidCharacter(offsetOf(p), "invalid character, ':' expected");
+          ++p;
+          state = State::MemberValue;
+          break;
+
+        case State::ArrayCommaOrEnd:
+        case State::ObjectCommaOrEnd: {
+          const bool isObject = state == State::ObjectCommaOrEnd;
+          if (*p == ',') {
+            ++p;
+            state = isObject ? State::ObjectKey : State::Value;
+          }
+          else if (*p == (isObject ? '}' : ']')) {
+            ++p;
+            closeContainer(offsetOf(p));
+          }
+          else {
+            return failWithInvalidCharacter(offsetOf(p), isObject ? "invalid character, ',' or '}' expected"
+                                                                  : "invalid character, ',' or ']' expected");
+          }
+          break;
+        }
+
+        case State::Stopped:
+        case State::Failed:
+          return;
+        }
+      }
+    }
+
+    void startToken(Token t, const char *p, size_t offset) {
+      token = t;
+      tokenPointer = p;
+      tokenOffset = offset;
+      isEscaped = false;
+    }
+    // advances p to the end of the token and returns true if the token ends before end,
+    // tokens other than strings include the next character, so they are parsed the same as by the regular parser
+    bool scanToken(const char *&p, const char *end) {
+      if (token == Token::Other) {
+        while (p != end && isTokenCharacter(*p))
+          ++p;
+        if (p == end)
+          return false;
+        ++p;
+        return true;
+      }
+      for (;;) {
+        if (isEscaped) {
+          if (p == end)
+            return false;
+          ++p;
+          isEscaped = false;
+        }
+        p = detail::skipPlainStringCharacters(p, end);
+        if (p == end)
+          return false;
+        switch (*p++) {
+        case '\"': return true;
+        case '\\': isEscaped = true; break;
+        default: break; // control characters are reported when the token is parsed
+        }
+      }
+    }
+    bool parseToken(std::string_view text, size_t &parsedSize) {
+      detail::ParserImpl<Allocator, ScalarBuilder&> parser{ text, options, allocator, scalarBuilder };
+      if (isKey)
+        keyOffset = tokenOffset;
+      const size_t keyStringsSize = keyStrings.size();
+      const bool isParsed = parser.parse({});
+      parsedSize = parser.parsedSize();
+      for (ParsingIssue issue : parser.issues) {
+        issue.offset += tokenOffset;
+        issues.push_back(issue);
+      }
+      if (!isParsed) {
+        if (isKey)
+          keyStrings.resize(keyStringsSize);
+        fail(tokenOffset + parsedSize);
+      }
+      else if (isKey) {
+        keySize = keyStrings.size() - keyStringsSize;
+      }
+      return isParsed;
+    }
+    bool emitKey(size_t valueOffset) {
+      Container &object = containers.back();
+      const size_t offset = keyStrings.size() - keySize;
+      const std::string_view key{ keyStrings.data() + offset, keySize };
+      bool isInserted = true;
+      if (options.duplicateObjectKeys != ParsingOptions::Option::Ignore)
+        isInserted = keys.insert(object.keys, { offset, keySize }, keyStrings);
+      handler.key(key);
+      if (options.duplicateObjectKeys == ParsingOptions::Option::Ignore || !isInserted)
+        keyStrings.resize(offset); // key is not needed for detection of duplicates
+      if (!isInserted) {
+        issues.push_back({ keyOffset, "JSON object contains duplicate keys", ParsingIssue::Code::DuplicateKeys });
+        if (options.duplicateObjectKeys == ParsingOptions::Option::Fail) {
+          fail(valueOffset);
+          return false;
+        }
+      }
+      state = State::Value;
+      return true;
+    }
+    void closeContainer(size_t offset) {
+      Container &c = containers.back();
+      if (c.isObject) {
+        keys.endObject(c.keys);
+        keyStrings.resize(c.keyStringsSize);
+        handler.endObject();
+      }
+      else {
+        handler.endArray();
+      }
+      containers.pop_back();
+      valueEnded(offset);
+    }
+    void valueEnded(size_t offset) {
+      if (containers.empty()) {
+        state = State::Done;
+        valueEndOffset = offset;
+      }
+      else {
+        state = containers.back().isObject ? State::ObjectCommaOrEnd : State::ArrayCommaOrEnd;
+      }
+    }
+    void fail(size_t offset) {
+      state = State::Failed;
+      failureOffset = offset;
+    }
+    bool checkDepth(size_t offset) {
+      if (containers.size() < options.maxDepth)
+        return true;
+      issues.push_back({ offset, "maximum nesting depth exceeded", ParsingIssue::Code::MaxDepthExceeded });
+      fail(offset);
+      return false;
+    }
+    void failWithInvalidCharacter(size_t offset, std::string_view description) {
+      issues.push_back({ offset, description, ParsingIssue::Code::InvalidCharacter });
+      fail(offset);
+    }
+
+    Handler &handler;
+    ParsingOptions options;
+    Allocator allocator;
+    typename Result::Issues issues;
+    ScalarHandler scalarHandler{ *this };
+    ScalarBuilder scalarBuilder;
+    std::vector<Container, detail::ReboundAllocator<Allocator, Container>> containers;
+
+    State state = State::Value;
+    size_t inputSize = 0;
+    size_t valueEndOffset = 0;
+    size_t garbageOffset = 0;
+    size_t failureOffset = 0;
+
+    Token token = Token::None;
+    const char *tokenPointer = nullptr; // beginning of the token in the current chunk
+    size_t tokenOffset = 0;
+    bool isEscaped = false;
+    bool isKey = false;
+    std::basic_string<char, std::char_traits<char>, detail::ReboundAllocator<Allocator, char>> pending; // incomplete token
+
+    // the last parsed key is at the end of keyStrings, keys of open objects precede it if duplicates are detected
+    typename Keys::Strings keyStrings;
+    size_t keyOffset = 0;
+    size_t keySize = 0;
+    Keys keys;
+  };
+  template<typename Handler>
+  using StreamingParser = BasicStreamingParser<Handler>;
 }
 
 namespace std {
-  template<typename A1, typename A2> // uses-allocator machinery support
-  struct uses_allocator<minjson::BasicValue<A1>, A2> : true_type {};
+  template<typename A1, typename P, typename A2> // uses-allocator machinery support
+  struct uses_allocator<minjson::BasicValue<A1, P>, A2> : true_type {};
 }
 
 #if defined(__clang__)
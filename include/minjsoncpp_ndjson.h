@@ -0,0 +1,180 @@
+﻿// Minimalistic JSON C++ library by Pavel Novikov (2024-2026)
+// for details see https://github.com/toughengineer/minjsoncpp
+// Parsing of newline delimited JSON using several threads, kept apart so the main header doesn't need threading headers
+#pragma once
+
+#include "minjsoncpp.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+
+namespace minjson {
+  template<typename Allocator, typename Policy = DefaultValuePolicy>
+  struct BasicNdjsonValue {
+    size_t line; // zero based
+    size_t offset; // of the line in the input
+    BasicParsingResult<Allocator, Policy> result; // parsedSize and offsets of issues are counted within the input
+  };
+  using NdjsonValue = BasicNdjsonValue<std::allocator<char>>;
+
+  namespace detail {
+    template<typename Allocator, typename Policy>
+    struct NdjsonBatch {
+      using Value = BasicNdjsonValue<Allocator, Policy>;
+      using Values = std::vector<Value, ReboundAllocator<Allocator, Value>>;
+
+      void parse(std::string_view input, const ParsingOptions &options, const Allocator &allocator) {
+        for (size_t begin = this->begin; begin != end; ++lineCount) {
+          const size_t newline = input.find('\n', begin);
+          const size_t lineEnd = newline < end ? newline : end;
+          const std::string_view line = input.substr(begin, lineEnd - begin);
+          const char *p = line.data();
+          if (!skipWhitespaces(p, line.data() + line.size())) { // lines of whitespace are skipped
+            auto result = minjson::parse<Allocator, Policy>(line, options, ParsingMode::VerifyTrailingWhitespace, allocator);
+            result.parsedSize += begin;
+            for (ParsingIssue &issue : result.issues)
+              issue.offset += begin;
+            values.push_back({ lineCount, begin, std::move(result) });
+          }
+          begin = lineEnd < end ? lineEnd + 1 : end;
+        }
+      }
+
+      size_t begin;
+      size_t end;
+      Values values;
+      size_t lineCount = 0;
+      bool isParsed = false;
+      std::exception_ptr exception;
+    };
+
+    template<typename Allocator, typename Policy, typename Callback>
+    void parseNdjson(std::string_view input, Callback &callback, const ParsingOptions &options, size_t threadCount,
+                     const Allocator &allocator) {
+      using Batch = NdjsonBatch<Allocator, Policy>;
+      constexpr size_t BatchSize = 256 * 1024;
+      std::vector<Batch, ReboundAllocator<Allocator, Batch>> batches{ allocator };
+      for (size_t begin = 0; begin != input.size();) { // batches consist of whole lines
+        const size_t newline = input.find('\n', std::min(begin + BatchSize, input.size()) - 1);
+        const size_t end = newline != std::string_view::npos ? newline + 1 : input.size();
+        batches.push_back({ begin, end, typename Batch::Values{ allocator } });
+        begin = end;
+      }
+
+      size_t lineCount = 0;
+      const auto deliver = [&callback, &lineCount](Batch &batch) {
+        for (auto &value : batch.values) {
+          value.line += lineCount;
+          callback(std::move(value));
+        }
+        lineCount += batch.lineCount;
+        batch.values = {};
+      };
+
+      if (threadCount == 0)
+        threadCount = std::thread::hardware_concurrency();
+      threadCount = std::min(threadCount, batches.size());
+      if (threadCount <= 1) {
+        for (Batch &batch : batches) {
+          batch.parse(input, options, allocator);
+          deliver(batch);
+        }
+        return;
+      }
+
+      // batches are taken by worker threads in order, and the calling thread delivers their values in the same order;
+      // workers can't get too far ahead, so memory use doesn't depend on the input size
+      const size_t maxBatchesInFlight = 2 * threadCount;
+      std::mutex mutex;
+      std::condition_variable batchParsed, batchDelivered;
+      size_t nextBatch = 0, deliveredBatches = 0;
+      bool isStopped = false;
+      const auto work = [&]() {
+        for (;;) {
+          std::unique_lock lock{ mutex };
+          batchDelivered.wait(lock, [&] {
+            return isStopped || nextBatch == batches.size() || nextBatch < deliveredBatches + maxBatchesInFlight;
+          });
+          if (isStopped || nextBatch == batches.size())
+            return;
+          Batch &batch = batches[nextBatch++];
+          lock.unlock();
+          try {
+            batch.parse(input, options, allocator);
+          }
+          catch (...) {
+            batch.exception = std::current_exception();
+          }
+          lock.lock();
+          batch.isParsed = true;
+          lock.unlock();
+          batchParsed.notify_all();
+        }
+      };
+
+      std::vector<std::thread> threads;
+      const auto stop = [&]() {
+        {
+          std::lock_guard lock{ mutex };
+          isStopped = true;
+        }
+        batchDelivered.notify_all();
+        for (std::thread &thread : threads)
+          thread.join();
+      };
+      try {
+        threads.reserve(threadCount);
+        for (size_t k = 0; k < threadCount; ++k)
+          threads.emplace_back(work);
+        for (Batch &batch : batches) {
+          {
+            std::unique_lock lock{ mutex };
+            batchParsed.wait(lock, [&batch] { return batch.isParsed; });
+          }
+          if (batch.exception)
+            std::rethrow_exception(batch.exception);
+          deliver(batch);
+          {
+            std::lock_guard lock{ mutex };
+            ++deliveredBatches;
+          }
+          batchDelivered.notify_all();
+        }
+      }
+      catch (...) {
+        stop();
+        throw;
+      }
+      stop();
+    }
+  }
+
+  // parses newline delimited JSON values (one value per line, lines of whitespace are skipped) using threadCount threads
+  // (number of hardware threads if 0), callback receives minjson::BasicNdjsonValue for each value in order of lines;
+  // allocator is used concurrently by several threads
+  template<typename Allocator = std::allocator<char>, typename Policy = DefaultValuePolicy, typename Callback>
+  std::enable_if_t<std::is_invocable_v<Callback&, BasicNdjsonValue<Allocator, Policy>&&>>
+    parseNdjson(std::string_view input,
+                Callback &&callback,
+                const ParsingOptions &options = {},
+                size_t threadCount = 0,
+                const Allocator &allocator = {}) {
+    detail::parseNdjson<Allocator, Policy>(input, callback, options, threadCount, allocator);
+  }
+
+  template<typename Allocator = std::allocator<char>, typename Policy = DefaultValuePolicy>
+  [[nodiscard]] std::vector<BasicNdjsonValue<Allocator, Policy>,
+    detail::ReboundAllocator<Allocator, BasicNdjsonValue<Allocator, Policy>>>
+    parseNdjson(std::string_view input,
+                const ParsingOptions &options = {},
+                size_t threadCount = 0,
+                const Allocator &allocator = {}) {
+    std::vector<BasicNdjsonValue<Allocator, Policy>,
+      detail::ReboundAllocator<Allocator, BasicNdjsonValue<Allocator, Policy>>> values{ allocator };
+    parseNdjson<Allocator, Policy>(input, [&values](auto &&value) { values.push_back(std::move(value)); },
+                                   options, threadCount, allocator);
+    return values;
+  }
+}
@@ -1,16 +1,15 @@
-#include <utility>  // dummy include to get _LIBCPP_VERSION
-// libc++ version 15 and earlier does not provide <memory_resource>
-#if !defined(_LIBCPP_VERSION) || _LIBCPP_VERSION >= 160000
 #include <minjsoncpp.h>
 
 #include "utils.h"
 
 #include "catch2/catch_amalgamated.hpp"
 
-#include <memory_resource>
-
 using namespace std::string_view_literals;
 
+// libc++ version 15 and earlier does not provide <memory_resource>
+#if !defined(_LIBCPP_VERSION) || _LIBCPP_VERSION >= 160000
+#include <memory_resource>
+
 #if defined(_GLIBCXX_RELEASE) && _GLIBCXX_RELEASE < 12 && defined(__clang__)
 // for some reason clang needs this
 static_assert(std::is_copy_constructible_v<minjson::BasicValue<std::pmr::polymorphic_allocator<char>>>);
@@ -96,4 +95,165 @@ TEST_CASE_METHOD(TestFixture, "parsing value using custom allocator", "[value][a
   REQUIRE(memoryResource.allocationCount == 0);
   REQUIRE(memoryResource.deallocationCount == 0);
 }
+
+
+TEST_CASE_METHOD(TestFixture, "compact strings using custom allocator", "[value][allocator][compact string]") {
+  using String = minjson::BasicCompactString<Allocator>;
+  const Allocator allocator = &memoryResource;
+  {
+    String s{ "short text", allocator };
+    String copy{ s, allocator };
+    copy += " still short"sv;
+    CHECK(memoryResource.allocationCount == 0);
+
+    s += " now grows longer than thirty characters"sv;
+    CHECK(memoryResource.allocationCount == 1);
+    String moved{ std::move(s), allocator };
+    CHECK(memoryResource.allocationCount == 1);
+    String copied{ moved, Allocator{ std::pmr::new_delete_resource() } };
+    CHECK(memoryResource.allocationCount == 1);
+  }
+  CHECK(memoryResource.deallocationCount == 1);
+}
 #endif  // !defined(_LIBCPP_VERSION) || _LIBCPP_VERSION >= 160000
+
+
+TEST_CASE("arena", "[allocator][arena]") {
+  minjson::Arena arena{ 256 };
+  CHECK(arena.chunkCount() == 0);
+
+  void *a = arena.allocate(1, 1);
+  void *b = arena.allocate(8, 8);
+  void *c = arena.allocate(16, 64);
+  CHECK(arena.chunkCount() == 1);
+  CHECK(reinterpret_cast<uintptr_t>(b) % 8 == 0);
+  CHECK(reinterpret_cast<uintptr_t>(c) % 64 == 0);
+  CHECK(static_cast<char*>(a) < static_cast<char*>(b));
+  CHECK(static_cast<char*>(b) < static_cast<char*>(c));
+
+  INFO("allocations not fitting into the current chunk go to a new one");
+  void *big = arena.allocate(1000, 128);
+  CHECK(reinterpret_cast<uintptr_t>(big) % 128 == 0);
+  std::memset(big, 0, 1000);
+  CHECK(arena.chunkCount() == 2);
+
+  INFO("moved arena takes chunks over");
+  minjson::Arena moved{ std::move(arena) };
+  CHECK(arena.chunkCount() == 0);
+  CHECK(moved.chunkCount() == 2);
+
+  moved.release();
+  CHECK(moved.chunkCount() == 0);
+  CHECK(moved.allocate(10, 1) != nullptr);
+  CHECK(moved.chunkCount() == 1);
+}
+
+
+TEST_CASE("creating value using arena allocator", "[value][allocator][arena]") {
+  minjson::Arena arena;
+  const minjson::ArenaAllocator<char> allocator{ arena };
+  using String = minjson::ArenaValue::String;
+  {
+    minjson::ArenaValue::Object o{ allocator };
+    o[String{ "foo", allocator }] = 42;
+    o[String{ "bar", allocator }] = String{ "a longish string of text", allocator };
+    o[String{ "baz", allocator }] = minjson::ArenaValue::Array{ { 1, 2, 3 }, allocator };
+    const minjson::ArenaValue v = std::move(o);
+    const minjson::ArenaValue copy{ v, allocator };
+    CHECK(copy == v);
+    CHECK(arena.chunkCount() == 1);
+    CHECK(minjson::serializeToString(*v.resolve("baz"), {}, {}, allocator) == "[1,2,3]");
+    CHECK(toString(v) == toString(minjson::parse(R"({"foo":42,"bar":"a longish string of text","baz":[1,2,3]})").value));
+  }
+  CHECK(arena.chunkCount() == 1);
+}
+
+
+TEMPLATE_TEST_CASE("parsing value into arena", "[parse][allocator][arena]",
+                   minjson::DefaultValuePolicy, minjson::FlatObjectValuePolicy) {
+  const auto json = R"({
+"foo": 42,
+"bar": "a longish string of text",
+"baz": [
+  1, 2.5, "three", "another longish string of text", { "nested": [ null, true, false ] }
+]
+})"sv;
+
+  SECTION("success") {
+    auto [document, status, parsedSize, issues] = minjson::parse<TestType>(json, minjson::Arena{});
+    CHECK(status == minjson::ParsingResultStatus::Success);
+    CHECK(parsedSize == json.size());
+    CHECK(issues.empty());
+    CHECK(document.arena().chunkCount() == 1);
+    CHECK(toString(document.value()) == toString(minjson::parse<std::allocator<char>, TestType>(json).value));
+
+    INFO("moved document keeps the value");
+    const auto moved = std::move(document);
+    CHECK(moved.value().resolve("baz", 4, "nested", 1)->asBool());
+    CHECK(&moved.value().resolve("bar")->asString().get_allocator().arena() == &moved.arena());
+  }
+
+  SECTION("lookup does not allocate from the arena") {
+    const auto input = R"({ "a key longer than small string buffer": { "another long key of nested object": 1 } })"sv;
+    const auto [document, status, parsedSize, issues] = minjson::parse<TestType>(input, minjson::Arena{ 64 });
+    REQUIRE(status == minjson::ParsingResultStatus::Success);
+    const size_t chunkCount = document.arena().chunkCount();
+    for (int i = 0; i < 100; ++i) {
+      CHECK(document.value().resolve("a key longer than small string buffer", "another long key of nested object"));
+      CHECK(document.value().resolve(minjson::JsonPointer{ "/a key longer than small string buffer" }));
+    }
+    CHECK(document.arena().chunkCount() == chunkCount);
+  }
+
+  SECTION("small chunks") {
+    const auto [document, status, parsedSize, issues] = minjson::parse<TestType>(json, minjson::Arena{ 64 });
+    CHECK(status == minjson::ParsingResultStatus::Success);
+    CHECK(document.arena().chunkCount() > 1);
+    CHECK(toString(document.value()) == toString(minjson::parse<std::allocator<char>, TestType>(json).value));
+  }
+
+  SECTION("issues outlive the document") {
+    minjson::ArenaParsingResult::Issues issues;
+    {
+      auto result = minjson::parse<TestType>(R"([ 1, 2 ] garbage)"sv, minjson::Arena{});
+      CHECK(result.status == minjson::ParsingResultStatus::PartialSuccess);
+      CHECK(result.parsedSize == 9);
+      CHECK(result.document.value().asArray().size() == 2);
+      issues = std::move(result.issues);
+    }
+    REQUIRE(issues.size() == 1);
+    CHECK(issues[0].offset == 9);
+  }
+}
+
+
+TEST_CASE("values using monotonic allocator", "[value][allocator][arena]") {
+  minjson::Arena arena;
+  const minjson::ArenaAllocator<char> allocator{ arena };
+  using String = minjson::ArenaValue::String;
+  using Array = minjson::ArenaValue::Array;
+
+  minjson::ArenaValue v = Array{ { String{ "a longish string of text", allocator }, 42, Array{ { 1, 2 }, allocator } },
+                                 allocator };
+  const minjson::ArenaValue copy{ v, allocator };
+  CHECK(copy == v);
+
+  INFO("replacing contents destroys only the replaced container, not its elements");
+  v = 42;
+  CHECK(v.asInt() == 42);
+  v = String{ "another longish string of text", allocator };
+  CHECK(v.asString() == "another longish string of text");
+  v = copy;
+  CHECK(v == copy);
+
+  minjson::ArenaValue moved{ std::move(v) };
+  CHECK(moved == copy);
+  CHECK(toString(moved) == R"([
+  "a longish string of text",
+  42,
+  [
+    1,
+    2
+  ]
+])");
+}
@@ -1,4 +1,5 @@
 #include <minjsoncpp.h>
+#include <minjsoncpp_ndjson.h>
 
 #include "utils.h"
 
@@ -6,6 +7,8 @@
 
 #include <iostream>
 #include <fstream>
+#include <random>
+#include <sstream>
 
 #if !defined(_LIBCPP_VERSION) || _LIBCPP_VERSION >= 160000
 #include <memory_resource>
@@ -31,6 +34,19 @@ struct DummySink {
   }
 };
 using PolymorphicSink = std::function<void(std::string_view)>;
+struct CountingHandler {
+  size_t count = 0;
+  void null() { ++count; }
+  void boolean(bool) { ++count; }
+  void integer(int64_t) { ++count; }
+  void decimal(double) { ++count; }
+  void string(std::string_view) { ++count; }
+  void startArray() { ++count; }
+  void endArray() {}
+  void startObject() { ++count; }
+  void key(std::string_view) {}
+  void endObject() {}
+};
 std::string loadFile(const std::string &filename) {
   std::ifstream file{ filename, std::ios_base::binary };
   if (!file.is_open())
@@ -43,6 +59,14 @@ const auto loremIpsum =
   "aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat. "
   "Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur. Excepteur "
   "sint occaecat cupidatat non proident, sunt in culpa qui officia deserunt mollit anim id est laborum."sv;
+const auto logRecord =
+  "2024-03-01T12:34:56.789Z INFO [http-worker-17] request completed: method=GET path=/api/v2/catalog/items "
+  "query=\"category=books&sort=price\" status=200 bytes=48213 duration_ms=12.7 user_agent=\"Mozilla/5.0 (X11; Linux "
+  "x86_64) AppleWebKit/537.36 (KHTML, like Gecko) Chrome/122.0.0.0 Safari/537.36\" trace_id=4bf92f3577b34da6\n"sv;
+const auto cyrillicText =
+  "\xD0\xA1\xD1\x8A\xD0\xB5\xD1\x88\xD1\x8C \xD0\xB6\xD0\xB5 \xD0\xB5\xD1\x89\xD1\x91 \xD1\x8D\xD1\x82\xD0\xB8\xD1\x85 "
+  "\xD0\xBC\xD1\x8F\xD0\xB3\xD0\xBA\xD0\xB8\xD1\x85 \xD1\x84\xD1\x80\xD0\xB0\xD0\xBD\xD1\x86\xD1\x83\xD0\xB7\xD1\x81\xD0\xBA\xD0\xB8\xD1\x85 "
+  "\xD0\xB1\xD1\x83\xD0\xBB\xD0\xBE\xD0\xBA, \xD0\xB4\xD0\xB0 \xD0\xB2\xD1\x8B\xD0\xBF\xD0\xB5\xD0\xB9 \xD1\x87\xD0\xB0\xD1\x8E"sv;
 }  // namespace
 
 TEST_CASE("escape benchmark (valid UTF-8 strings)", "[escape][!benchmark]") {
@@ -51,7 +75,9 @@ TEST_CASE("escape benchmark (valid UTF-8 strings)", "[escape][!benchmark]") {
       "some ASCII character to escape: \t \" \\ \n"
       "utf8 2 byte code point \xC2\xA3 3 byte code point \xE2\x82\xAC 4 byte code point \xF0\x9F\x98\x80 characters"sv,
       "string with characters to escape" },
-    std::pair{ loremIpsum, "lorem ipsum" });
+    std::pair{ loremIpsum, "lorem ipsum" },
+    std::pair{ logRecord, "log record" },
+    std::pair{ cyrillicText, "mostly non-ASCII text" });
 
   DYNAMIC_SECTION(name) {
     const auto string = theString;  // BENCHMARK() macro does not support capturing structured bindings in C++17
@@ -182,6 +208,9 @@ TEST_CASE("serialization benchmark", "[serialization][!benchmark]") {
     BENCHMARK("string") {
       return minjson::serializeToString(v).size();
     };
+    BENCHMARK("string (exact size)") {
+      return minjson::serializeToString(v, {}, minjson::StringAllocation::ExactSize).size();
+    };
     BENCHMARK("string /w reserve") {
       StringSink sink{};
       minjson::impl::serialize(sink, v, {});
@@ -197,6 +226,16 @@ TEST_CASE("serialization benchmark", "[serialization][!benchmark]") {
       minjson::impl::serialize<PolymorphicSink>(sink, v, {});
       return sink.size;
     };
+    BENCHMARK("stream") {
+      std::ostringstream stream;
+      minjson::impl::serialize(minjson::StdOStreamSink{ stream }, v, {});
+      return stream.tellp();
+    };
+    BENCHMARK("buffered stream") {
+      std::ostringstream stream;
+      minjson::impl::serialize(minjson::BufferedSink<minjson::StdOStreamSink>{ { stream } }, v, {});
+      return stream.tellp();
+    };
   }
 
   minjson::SerializationOptions options;
@@ -264,10 +303,61 @@ TEST_CASE("serialization benchmark", "[serialization][!benchmark]") {
       minjson::impl::serialize(sink, v, options);
       return sink.size;
     };
+    BENCHMARK("stream") {
+      std::ostringstream stream;
+      minjson::impl::serialize(minjson::StdOStreamSink{ stream }, v, options);
+      return stream.tellp();
+    };
+    BENCHMARK("buffered stream") {
+      std::ostringstream stream;
+      minjson::impl::serialize(minjson::BufferedSink<minjson::StdOStreamSink>{ { stream } }, v, options);
+      return stream.tellp();
+    };
   }
 }
 
 
+TEST_CASE("decimal numbers serialization benchmark", "[serialization][!benchmark]") {
+  // coordinates like in canada.json
+  minjson::Array coordinates;
+  std::mt19937_64 random{ 42 };
+  std::uniform_real_distribution<double> longitude{ -141., -52. }, latitude{ 41., 83. };
+  for (int i = 0; i < 10'000; ++i) {
+    auto &pair = coordinates.emplace_back(minjson::Array{}).asArray();
+    pair.emplace_back(longitude(random));
+    pair.emplace_back(latitude(random));
+  }
+  const minjson::Value v = std::move(coordinates);
+
+  BENCHMARK("std::to_chars() (baseline)") {
+    char buf[32];
+    size_t size = 0;
+    for (const auto &pair : v.asArray())
+      for (const auto &number : pair.asArray())
+        size += static_cast<size_t>(std::to_chars(buf, buf + sizeof(buf), number.asDouble()).ptr - buf);
+    return size;
+  };
+  BENCHMARK("string") {
+    return minjson::serializeToString(v).size();
+  };
+  BENCHMARK("string (exact size)") {
+    return minjson::serializeToString(v, {}, minjson::StringAllocation::ExactSize).size();
+  };
+  BENCHMARK("dummy sink") {
+    DummySink sink;
+    minjson::impl::serialize(sink, v, {});
+    return sink.size;
+  };
+  minjson::SerializationOptions options;
+  options.decimal.precision = 6;
+  BENCHMARK("dummy sink, precision 6") {
+    DummySink sink;
+    minjson::impl::serialize(sink, v, options);
+    return sink.size;
+  };
+}
+
+
 TEST_CASE("unescape benchmark (valid escapes)", "[unescape][!benchmark]") {
   const auto [theString, name] = GENERATE(
     std::pair{ R"(some ASCII character escapes: \b \f \n \r \t \" \\ )"
@@ -375,6 +465,27 @@ TEST_CASE("parsing benchmark", "[parse][!benchmark]") {
       return minjson::parse(string, {}, {}, std::pmr::polymorphic_allocator<char>{ &pool }).parsedSize;
     };
 #endif
+
+    BENCHMARK("arena") {
+      return minjson::parse(string, minjson::Arena{}).parsedSize;
+    };
+  }
+
+  SECTION("integers") {
+    // IDs and timestamps of various lengths
+    std::string string = "[";
+    uint64_t x = 88172645463325252ull;
+    for (int k = 0; k < 100000; ++k) {
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      string += std::to_string(x >> (x % 56)) + (k % 2 ? ", " : ", -");
+    }
+    string += "0]";
+
+    BENCHMARK("default") {
+      return minjson::parse(string).parsedSize;
+    };
   }
 
   // canada.json from https://github.com/mloskot/json_benchmark/blob/master/data/canada.json
@@ -388,6 +499,67 @@ TEST_CASE("parsing benchmark", "[parse][!benchmark]") {
     BENCHMARK("default") {
       return minjson::parse(input).parsedSize;
     };
+    BENCHMARK("load file, then parse") {
+      return minjson::parse(loadFile(filename)).parsedSize;
+    };
+    BENCHMARK("parse memory mapped file") {
+      return minjson::parseFile(filename).parsedSize;
+    };
+    BENCHMARK("structural index engine") {
+      minjson::ParsingOptions options;
+      options.engine = minjson::ParsingOptions::Engine::StructuralIndex;
+      return minjson::parse(input, options).parsedSize;
+    };
+    BENCHMARK("zero-copy") {
+      return minjson::parseZeroCopy(input).parsedSize;
+    };
+    BENCHMARK("document") {
+      return minjson::parseDocument(input).parsedSize;
+    };
+    BENCHMARK("SAX (counting handler)") {
+      CountingHandler handler;
+      (void)minjson::parseSax(input, handler);
+      return handler.count;
+    };
+    BENCHMARK("streaming SAX (4 KiB chunks)") {
+      CountingHandler handler;
+      minjson::StreamingParser<CountingHandler> parser{ handler };
+      for (size_t i = 0; i < input.size(); i += 4096)
+        parser.feed(std::string_view{ input }.substr(i, 4096));
+      (void)parser.finish();
+      return handler.count;
+    };
+    BENCHMARK("streaming DOM (4 KiB chunks)") {
+      minjson::ValueHandler handler;
+      minjson::StreamingParser<minjson::ValueHandler> parser{ handler };
+      for (size_t i = 0; i < input.size(); i += 4096)
+        parser.feed(std::string_view{ input }.substr(i, 4096));
+      return parser.finish().parsedSize;
+    };
+    BENCHMARK("flat object") {
+      return minjson::parse<std::allocator<char>, minjson::FlatObjectValuePolicy>(input).parsedSize;
+    };
+    BENCHMARK("sorted flat object") {
+      return minjson::parse<std::allocator<char>, minjson::SortedFlatObjectValuePolicy>(input).parsedSize;
+    };
+    BENCHMARK("compact strings") {
+      return minjson::parse<std::allocator<char>, minjson::CompactStringValuePolicy>(input).parsedSize;
+    };
+    {
+      minjson::KeyDictionary dictionary;
+      minjson::ParsingOptions options;
+      options.keyDictionary = &dictionary;
+      BENCHMARK("interned keys") {
+        return minjson::parse<std::allocator<char>, minjson::InternedKeysValuePolicy>(input, options).parsedSize;
+      };
+    }
+    BENCHMARK_ADVANCED("in situ")(Catch::Benchmark::Chronometer meter) {
+      std::vector<std::string> buffers(static_cast<size_t>(meter.runs()), input);
+      meter.measure([&buffers](int i) {
+        auto &buffer = buffers[static_cast<size_t>(i)];
+        return minjson::parseInSitu(buffer.data(), buffer.size()).parsedSize;
+      });
+    };
 #if defined(POLYMORPHIC_ALLOCATOR_IS_SUPPORTED)
     BENCHMARK("pmr allocator: buffer->heap") {
       std::pmr::monotonic_buffer_resource buffer{ std::pmr::new_delete_resource() };
@@ -399,5 +571,66 @@ TEST_CASE("parsing benchmark", "[parse][!benchmark]") {
       return minjson::parse(input, {}, {}, std::pmr::polymorphic_allocator<char>{ &pool }).parsedSize;
     };
 #endif
+    BENCHMARK("arena") {
+      return minjson::parse(input, minjson::Arena{}).parsedSize;
+    };
   }
 }
+
+
+TEST_CASE("JSON Pointers benchmark", "[json pointer][!benchmark]") {
+  const std::string input = loadFile("citm_catalog.json");
+  std::vector<std::string> paths{ "/events/138586341/name", "/areaNames/205705993", "/venueNames/PLEYEL_PLEYEL" };
+  for (int i = 0; i < 32; ++i)
+    paths.push_back("/performances/" + std::to_string(i * 7) + "/prices/0/amount");
+  const std::vector<minjson::JsonPointer> pointers(paths.begin(), paths.end());
+  const minjson::JsonPointerSet pointerSet{ paths.begin(), paths.end() };
+  const auto value = minjson::parse(input).value;
+  const auto document = minjson::parseDocument(input).document;
+
+  BENCHMARK("resolve pointers one by one") {
+    size_t found = 0;
+    for (const auto &pointer : pointers)
+      found += pointer.resolve(value) != nullptr;
+    return found;
+  };
+  BENCHMARK("resolve pointer set") {
+    return pointerSet.resolve(value).size();
+  };
+  BENCHMARK("resolve pointers one by one (document)") {
+    size_t found = 0;
+    for (const auto &pointer : pointers)
+      found += pointer.resolve(document).has_value();
+    return found;
+  };
+  BENCHMARK("resolve pointer set (document)") {
+    return pointerSet.resolve(document).size();
+  };
+  BENCHMARK("parse, then resolve pointer set") {
+    return pointerSet.resolve(minjson::parse(input).value).size();
+  };
+  BENCHMARK("extract") {
+    return minjson::extract(input, pointerSet).values.size();
+  };
+  BENCHMARK("parse projection, then resolve pointer set") {
+    return pointerSet.resolve(minjson::parseProjected(input, pointerSet).value).size();
+  };
+}
+
+
+TEST_CASE("NDJSON parsing benchmark", "[parse][ndjson][!benchmark]") {
+  // lines are performances from citm_catalog.json
+  const auto catalog = minjson::parse(loadFile("citm_catalog.json")).value;
+  std::string input;
+  while (input.size() < 16 * 1024 * 1024) {
+    for (const auto &performance : catalog.resolve("performances")->asArray())
+      input += minjson::serializeToString(performance) + '\n';
+  }
+
+  BENCHMARK("single thread") {
+    return minjson::parseNdjson(input, {}, 1).size();
+  };
+  BENCHMARK("all hardware threads") {
+    return minjson::parseNdjson(input).size();
+  };
+}
@@ -106,6 +106,7 @@ struct MyIndex {
 // test that `resolve()` is allowed with arguments convertible to string or size_t
 static_assert(IsResolveAllowed<const char *>);
 static_assert(IsResolveAllowed<std::string>);
+static_assert(IsResolveAllowed<std::string_view>);
 static_assert(IsResolveAllowed<MyString>);
 static_assert(IsResolveAllowed<int>);
 static_assert(IsResolveAllowed<size_t>);
@@ -115,6 +116,7 @@ static_assert(IsResolveAllowed<const char *, std::string>);
 static_assert(IsResolveAllowed<const char *, MyString>);
 static_assert(IsResolveAllowed<std::string, MyString>);
 static_assert(IsResolveAllowed<const char *, std::string, MyString>);
+static_assert(IsResolveAllowed<std::string_view, std::string>);
 
 static_assert(IsResolveAllowed<int, size_t>);
 static_assert(IsResolveAllowed<int, MyIndex>);
@@ -130,6 +132,7 @@ static_assert(IsResolveAllowed<MyString, MyIndex, MyIndex, MyString>);
 static_assert(!IsResolveAllowed<void *>);
 static_assert(!IsResolveAllowed<std::vector<char>>);
 static_assert(!IsResolveAllowed<std::vector<size_t>>);
+static_assert(!IsResolveAllowed<minjson::JsonPointer, int>);
 
 
 struct DummyVisitor {
@@ -282,3 +285,25 @@ auto testSinkApi() {
   const auto result = minjson::impl::parse({}, {}, std::allocator<char>{});
   return result;
 }
+
+
+// values using monotonic allocators are not destroyed
+static_assert(!std::is_trivially_destructible_v<minjson::Value>);
+static_assert(std::is_trivially_destructible_v<minjson::ArenaValue>);
+static_assert(std::is_trivially_destructible_v<minjson::BasicValue<minjson::ArenaAllocator<char>,
+                                                                   minjson::FlatObjectValuePolicy>>);
+static_assert(std::is_nothrow_move_constructible_v<minjson::ArenaValue>);
+static_assert(std::is_copy_constructible_v<minjson::ArenaValue>);
+static_assert(minjson::IsMonotonicAllocator<minjson::ArenaAllocator<char>>);
+static_assert(!minjson::IsMonotonicAllocator<std::allocator<char>>);
+
+
+// compact strings have the same size as std::string in libstdc++ and store up to 30 characters inline,
+// in values they take the space of the largest other alternative
+static_assert(sizeof(minjson::BasicCompactString<std::allocator<char>>) == 32);
+static_assert(minjson::BasicCompactString<std::allocator<char>>::InlineCapacity == 30);
+static_assert(std::is_nothrow_move_constructible_v<minjson::BasicCompactString<std::allocator<char>>>);
+static_assert(sizeof(minjson::CompactStringValue) == sizeof(minjson::Value));
+static_assert(sizeof(minjson::BasicValue<minjson::ArenaAllocator<char>, minjson::CompactStringValuePolicy>) ==
+              sizeof(minjson::ArenaValue));
+static_assert(minjson::CompactStringValue::String::InlineCapacity > 30);
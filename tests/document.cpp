@@ -0,0 +1,207 @@
+#include <minjsoncpp.h>
+
+#include "utils.h"
+
+#include "catch2/catch_amalgamated.hpp"
+
+using namespace std::string_view_literals;
+
+TEST_CASE("document navigation", "[document]") {
+  const auto string =
+    R"({ "null": null, "bool": true, "int": -42, "double": 2.5, "string": "escaped \"value\"",
+         "array": [ 1, [ 2, 3 ], { "a": "b" }, "" ], "object": { "nested": { "key": false } }, "empty": {} })"sv;
+
+  const auto [document, status, parsedSize, issues] = minjson::parseDocument(string);
+  INFO(PrintIssues{ issues });
+  REQUIRE(status == minjson::ParsingResultStatus::Success);
+  CHECK(parsedSize == string.size());
+
+  const minjson::DocumentElement root = document.root();
+  REQUIRE(root.isObject());
+  const auto object = root.asObject();
+  CHECK(object.size() == 8);
+  CHECK_FALSE(object.empty());
+
+  const auto keys = std::invoke([&object] {
+    std::vector<std::string_view> keys;
+    for (const auto &[key, value] : object)
+      keys.push_back(key);
+    return keys;
+  });
+  CHECK(keys == std::vector{ "null"sv, "bool"sv, "int"sv, "double"sv, "string"sv, "array"sv, "object"sv, "empty"sv });
+
+  CHECK((*object.find("null")).second.isNull());
+  CHECK((*object.find("bool")).second.asBool() == true);
+  CHECK((*object.find("int")).second.asInt() == -42);
+  CHECK((*object.find("double")).second.asDouble() == 2.5);
+  CHECK((*object.find("string")).second.asString() == "escaped \"value\"");
+  CHECK(object.find("missing") == object.end());
+  CHECK_THROWS_AS((*object.find("int")).second.asString(), std::bad_variant_access);
+  CHECK_THROWS_AS((*object.find("string")).second.asArray(), std::bad_variant_access);
+
+  const auto array = (*object.find("array")).second.asArray();
+  REQUIRE(array.size() == 4);
+  CHECK(array[0].asInt() == 1);
+  CHECK(array[1].asArray().size() == 2);
+  CHECK(array[1].asArray()[1].asInt() == 3);
+  CHECK(array[2].asObject().size() == 1);
+  CHECK(array[3].asString().empty());
+  CHECK(std::distance(array.begin(), array.end()) == 4);
+
+  CHECK((*object.find("empty")).second.asObject().empty());
+
+  SECTION("resolve") {
+    CHECK(document.resolve("object", "nested", "key")->asBool() == false);
+    CHECK(root.resolve("array", 1, 0)->asInt() == 2);
+    CHECK(root.resolve("array", 2, "a")->asString() == "b");
+    CHECK_FALSE(root.resolve("array", 4));
+    CHECK_FALSE(root.resolve("missing", "key"));
+    CHECK_FALSE(root.resolve("int", 0));
+  }
+
+  SECTION("resolve JSON Pointer") {
+    CHECK(minjson::JsonPointer{ "/object/nested/key" }.resolve(document)->asBool() == false);
+    CHECK(document.resolve(minjson::JsonPointer{ "/array/1/0" })->asInt() == 2);
+    CHECK(root.resolve(minjson::JsonPointer{ "/array/2/a" })->asString() == "b");
+    CHECK(minjson::JsonPointer{ "" }.resolve(root)->isObject());
+    CHECK_FALSE(minjson::JsonPointer{ "/array/4" }.resolve(root));
+    CHECK_FALSE(minjson::JsonPointer{ "/array/01" }.resolve(root));
+    CHECK_FALSE(minjson::JsonPointer{ "/missing/key" }.resolve(root));
+    CHECK_FALSE(minjson::JsonPointer{ "/int/0" }.resolve(root));
+  }
+
+  SECTION("resolve set of JSON Pointers") {
+    const minjson::JsonPointerSet pointers{ "/array/2/a", "/object/nested/key", "/array/1/1", "/array/9", "/int",
+                                            "/array/1/0", "/array/2/a" };
+    const auto resolved = pointers.resolve(document);
+    REQUIRE(resolved.size() == 7);
+    CHECK(resolved[0]->asString() == "b");
+    CHECK(resolved[1]->asBool() == false);
+    CHECK(resolved[2]->asInt() == 3);
+    CHECK_FALSE(resolved[3]);
+    CHECK(resolved[4]->asInt() == -42);
+    CHECK(resolved[5]->asInt() == 2);
+    CHECK(resolved[6]->asString() == "b");
+  }
+
+  SECTION("visit") {
+    size_t count = 0;
+    for (const auto &[key, value] : object) {
+      minjson::visit([&count, key = key](const auto &v) {
+        using T = std::decay_t<decltype(v)>;
+        ++count;
+        if constexpr (std::is_same_v<T, minjson::Null>)
+          CHECK(key == "null");
+        else if constexpr (std::is_same_v<T, bool>)
+          CHECK(key == "bool");
+        else if constexpr (std::is_same_v<T, int64_t>)
+          CHECK(key == "int");
+        else if constexpr (std::is_same_v<T, double>)
+          CHECK(key == "double");
+        else if constexpr (std::is_same_v<T, std::string_view>)
+          CHECK(key == "string");
+        else if constexpr (std::is_same_v<T, minjson::DocumentElement::Array>)
+          CHECK(key == "array");
+        else if constexpr (std::is_same_v<T, minjson::DocumentElement::Object>)
+          CHECK((key == "object" || key == "empty"));
+      }, value);
+    }
+    CHECK(count == object.size());
+  }
+
+  SECTION("serialize") {
+    minjson::SerializationOptions options;
+    options.sortObjectKeys = GENERATE(false, true);
+    options.indent = GENERATE(0, 2);
+    CAPTURE(options.sortObjectKeys, options.indent);
+
+    if (options.sortObjectKeys) {
+      const auto value = minjson::parse(string).value;
+      CHECK(minjson::serializeToString(document, options) == minjson::serializeToString(value, options));
+    }
+    else {
+      CHECK(minjson::serializeToString(root, options) ==
+            (options.indent ?
+             R"({
+  "null":null,
+  "bool":true,
+  "int":-42,
+  "double":2.5,
+  "string":"escaped \"value\"",
+  "array":[
+    1,
+    [
+      2,
+      3
+    ],
+    {
+      "a":"b"
+    },
+    ""
+  ],
+  "object":{
+    "nested":{
+      "key":false
+    }
+  },
+  "empty":{}
+})"sv :
+             R"({"null":null,"bool":true,"int":-42,"double":2.5,"string":"escaped \"value\"",)"
+             R"("array":[1,[2,3],{"a":"b"},""],"object":{"nested":{"key":false}},"empty":{}})"sv));
+    }
+  }
+}
+
+
+TEST_CASE("parse document", "[document][parse]") {
+  minjson::ParsingOptions options;
+  options.engine = GENERATE(minjson::ParsingOptions::Engine::Default, minjson::ParsingOptions::Engine::StructuralIndex);
+  options.duplicateObjectKeys = GENERATE(minjson::ParsingOptions::Option::Ignore,
+                                         minjson::ParsingOptions::Option::Report,
+                                         minjson::ParsingOptions::Option::Fail);
+
+  const auto largeObject = std::invoke([] {
+    std::string s = "{";
+    for (int i = 0; i < 100; ++i)
+      s += "\"key" + std::to_string(i) + "\": " + std::to_string(i) + ", ";
+    return s;
+  });
+  using Input = std::tuple<std::string, const char *, int, const char *>; // keys are null without duplicate keys
+  // clang-format off
+  const auto [string, duplicateKey, firstValue, lastKey] = GENERATE_COPY(
+    Input{ R"([ "surrogates 😀 \ud83d", 1e3, -0, 9223372036854775807, [ [ [] ] ], {}, "é" ])", nullptr, 0, nullptr },
+    Input{ R"({ "a": 1, "b": { "a": 2, "b": "\u0062" }, "a": [ "3" ], "c": 4 })", "a", 1, "c" },
+    Input{ largeObject + R"("key42": "0", "last": [] })", "key42", 42, "last" },
+    Input{ largeObject + R"("last": [] })", nullptr, 0, nullptr },
+    Input{ R"({ "": 1, "": 2 })", "", 1, "" },
+    Input{ R"({ "a": [ 1, 2 )", nullptr, 0, nullptr },
+    Input{ R"([ "a" ] garbage)", nullptr, 0, nullptr });
+  // clang-format on
+  CAPTURE(string, options.duplicateObjectKeys);
+
+  const auto expected = minjson::parse(string, options);
+  const auto [document, status, parsedSize, issues] = minjson::parseDocument(string, options);
+  INFO(PrintIssues{ issues });
+  CHECK(status == expected.status);
+  CHECK(parsedSize == expected.parsedSize);
+  REQUIRE(issues.size() == expected.issues.size());
+  for (size_t k = 0; k < issues.size(); ++k) {
+    CHECK(issues[k].code == expected.issues[k].code);
+    CHECK(issues[k].offset == expected.issues[k].offset);
+  }
+  if (status == minjson::ParsingResultStatus::Failure) {
+    CHECK(document.root().isNull());
+  }
+  else if (!duplicateKey) {
+    minjson::SerializationOptions serializationOptions;
+    serializationOptions.sortObjectKeys = true;
+    CHECK(minjson::serializeToString(document, serializationOptions) ==
+          minjson::serializeToString(expected.value, serializationOptions));
+  }
+  else { // first of duplicate members is kept
+    const auto object = document.root().asObject();
+    CHECK(object.size() == expected.value.asObject().size());
+    CHECK((*object.find(duplicateKey)).second.asInt() == firstValue);
+    CHECK((*std::next(object.begin(), static_cast<std::ptrdiff_t>(object.size() - 1))).first == lastKey);
+  }
+}
@@ -4,6 +4,8 @@
 
 #include "catch2/catch_amalgamated.hpp"
 
+#include <random>
+
 using namespace std::string_view_literals;
 
 TEST_CASE("escape valid UTF-8 strings", "[escape][serialize]") {
@@ -195,6 +197,80 @@ TEST_CASE("escape valid UTF-8 strings", "[escape][serialize]") {
 }
 
 
+TEST_CASE("escape long strings", "[escape]") {
+  const auto position = GENERATE(range(size_t{ 0 }, size_t{ 70 }));  // covers several vector sized chunks
+  const std::string prefix(position, 'a');
+  const std::string suffix(70 - position, 'b');
+  const auto FailOnInvalidUtf8CodeUnits = minjson::Utf8Validation::FailOnInvalidUtf8CodeUnits;
+
+  SECTION("common escape character") {
+    const auto string = prefix + "\""sv + suffix;
+    CHECK(minjson::escape(string) == prefix + R"(\")"sv + suffix);
+    CHECK(minjson::escape(string, minjson::Escape::NonAscii, FailOnInvalidUtf8CodeUnits) ==
+          prefix + R"(\")"sv + suffix);
+  }
+
+  SECTION("control character") {
+    const auto string = prefix + "\x01"sv + suffix;
+    CHECK(minjson::escape(string) == prefix + R"(\u0001)"sv + suffix);
+    CHECK(minjson::escape(string, minjson::Escape::NonAscii, FailOnInvalidUtf8CodeUnits) ==
+          prefix + R"(\u0001)"sv + suffix);
+  }
+
+  SECTION("multibyte code point") {
+    const auto string = prefix + "\xE2\x82\xAC"sv + suffix;
+    CHECK(minjson::escape(string) == string);
+    CHECK(minjson::escape(string, {}, FailOnInvalidUtf8CodeUnits) == string);
+    CHECK(minjson::escape(string, minjson::Escape::NonAscii) == prefix + R"(\u20ac)"sv + suffix);
+  }
+
+  SECTION("invalid code unit") {
+    const auto string = prefix + "\xA3"sv + suffix;
+    auto dummy = [](std::string_view) {};  // dummy sink
+    CHECK(minjson::escape(string) == string);
+    CHECK(minjson::escape(string, minjson::Escape::NonAscii) == string);
+    CHECK(minjson::impl::escape(dummy, string, {}, FailOnInvalidUtf8CodeUnits, {}) == position);
+    CHECK(minjson::impl::escape(dummy, string, minjson::Escape::NonAscii, FailOnInvalidUtf8CodeUnits, {}) == position);
+  }
+
+  SECTION("invalid lead byte") {
+    const auto string = prefix + "\xF8\x80\x80\x80"sv + suffix;
+    auto dummy = [](std::string_view) {};  // dummy sink
+    CHECK(minjson::impl::escape(dummy, string, {}, FailOnInvalidUtf8CodeUnits, {}) == position);
+  }
+
+  SECTION("incomplete code point at the end") {
+    const auto [incomplete, complete] = GENERATE(std::pair{ "\xC2"sv, "\xC2\xA3"sv },
+                                                 std::pair{ "\xE2\x82"sv, "\xE2\x82\xAC"sv },
+                                                 std::pair{ "\xF0\x9F\x98"sv, "\xF0\x9F\x98\x80"sv });
+    auto dummy = [](std::string_view) {};  // dummy sink
+    CHECK(minjson::impl::escape(dummy, prefix + incomplete, {}, FailOnInvalidUtf8CodeUnits, {}) == position);
+    CHECK(minjson::escape(prefix + complete, {}, FailOnInvalidUtf8CodeUnits) == prefix + complete);
+  }
+}
+
+
+TEST_CASE("validate UTF-8 in random strings", "[escape][invalid utf8]") {
+  // escaping non-ASCII characters validates code points one by one which is the reference for validating whole strings
+  constexpr char codeUnits[] = { 'a', '\xC2', '\xA3', '\xE2', '\x82', '\xAC', '\xF0', '\x9F', '\x98', '\xF8' };
+  std::mt19937 generator{ 42 };
+  std::uniform_int_distribution<size_t> codeUnitDistribution{ 0, std::size(codeUnits) - 1 };
+  std::uniform_int_distribution<size_t> sizeDistribution{ 0, 100 };
+  auto dummy = [](std::string_view) {};  // dummy sink
+  for (int k = 0; k < 10000; ++k) {
+    std::string string(sizeDistribution(generator), 'a');
+    for (char &c : string)
+      if (codeUnitDistribution(generator) % 2)  // keeping roughly half of the string ASCII
+        c = codeUnits[codeUnitDistribution(generator)];
+    CAPTURE(NonPrintStr{ string });
+    const size_t expected = minjson::impl::escape(dummy, string, minjson::Escape::NonAscii,
+                                                  minjson::Utf8Validation::FailOnInvalidUtf8CodeUnits, {});
+    REQUIRE(minjson::impl::escape(dummy, string, {}, minjson::Utf8Validation::FailOnInvalidUtf8CodeUnits, {}) ==
+            expected);
+  }
+}
+
+
 TEST_CASE("escape invalid UTF-8 strings", "[escape][serialize][invalid utf8]") {
   using pair = std::pair<std::string_view, std::string_view>;
 
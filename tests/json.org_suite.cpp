@@ -10,6 +10,9 @@ using namespace std::string_view_literals;
 // https://www.json.org/JSON_checker/test.zip
 
 TEST_CASE("JSON.org suite: pass", "[parse][JSON.org][pass]") {
+  minjson::ParsingOptions options;
+  options.engine = GENERATE(minjson::ParsingOptions::Engine::Default, minjson::ParsingOptions::Engine::StructuralIndex);
+
   SECTION("pass1.json") {
     const auto string = R"([
     "JSON Test Pattern pass1",
@@ -70,7 +73,7 @@ TEST_CASE("JSON.org suite: pass", "[parse][JSON.org][pass]") {
 1e00,2e+00,2e-00
 ,"rosebud"])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Success);
     CHECK(parsedSize == string.size());
     CHECK(issues.empty());
@@ -79,7 +82,7 @@ TEST_CASE("JSON.org suite: pass", "[parse][JSON.org][pass]") {
   SECTION("pass2.json") {
     const auto string = R"([[[[[[[[[[[[[[[[[[["Not too deep"]]]]]]]]]]]]]]]]]]])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Success);
     CHECK(parsedSize == string.size());
     CHECK(issues.empty());
@@ -94,7 +97,7 @@ TEST_CASE("JSON.org suite: pass", "[parse][JSON.org][pass]") {
 }
 )"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Success);
     CHECK(parsedSize == string.size());
     CHECK(issues.empty());
@@ -103,10 +106,13 @@ TEST_CASE("JSON.org suite: pass", "[parse][JSON.org][pass]") {
 
 
 TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
+  minjson::ParsingOptions options;
+  options.engine = GENERATE(minjson::ParsingOptions::Engine::Default, minjson::ParsingOptions::Engine::StructuralIndex);
+
   SECTION("fail1.json") {
     const auto string = R"("A JSON payload should be an object or array, not a string.")"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Success);
     CHECK(parsedSize == string.size());
     CHECK(issues.empty());
@@ -119,7 +125,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail2.json") {
     const auto string = R"(["Unclosed array")"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == string.size());
     REQUIRE(issues.size() == 1);
@@ -130,7 +136,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail3.json") {
     const auto string = R"({unquoted_key: "keys must be quoted"})"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 1);
     REQUIRE(issues.size() == 1);
@@ -141,7 +147,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail4.json") {
     const auto string = R"(["extra comma",])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 15);
     REQUIRE(issues.size() == 1);
@@ -152,7 +158,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail5.json") {
     const auto string = R"(["double extra comma",,])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 22);
     REQUIRE(issues.size() == 1);
@@ -163,7 +169,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail6.json") {
     const auto string = R"([   , "<-- missing value"])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 4);
     REQUIRE(issues.size() == 1);
@@ -174,7 +180,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail7.json") {
     const auto string = R"(["Comma after the close"],)"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::PartialSuccess);
     CHECK(parsedSize == 25);
     REQUIRE(issues.size() == 1);
@@ -185,7 +191,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail8.json") {
     const auto string = R"(["Extra close"]])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::PartialSuccess);
     CHECK(parsedSize == 15);
     REQUIRE(issues.size() == 1);
@@ -196,7 +202,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail9.json") {
     const auto string = R"({"Extra comma": true,})"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 21);
     REQUIRE(issues.size() == 1);
@@ -207,7 +213,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail10.json") {
     const auto string = R"({"Extra value after close": true} "misplaced quoted value")"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::PartialSuccess);
     CHECK(parsedSize == 34);
     REQUIRE(issues.size() == 1);
@@ -218,7 +224,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail11.json") {
     const auto string = R"({"Illegal expression": 1 + 2})"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 25);
     REQUIRE(issues.size() == 1);
@@ -229,7 +235,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail12.json") {
     const auto string = R"({"Illegal invocation": alert()})"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 23);
     REQUIRE(issues.size() == 1);
@@ -240,7 +246,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail13.json") {
     const auto string = R"({"Numbers cannot have leading zeroes": 013})"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 40);
     REQUIRE(issues.size() == 1);
@@ -251,7 +257,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail14.json") {
     const auto string = R"({"Numbers cannot be hex": 0x14})"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 27);
     REQUIRE(issues.size() == 1);
@@ -262,7 +268,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail15.json") {
     const auto string = R"(["Illegal backslash escape: \x15"])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 29);
     REQUIRE(issues.size() == 1);
@@ -273,7 +279,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail16.json") {
     const auto string = R"([\naked])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 1);
     REQUIRE(issues.size() == 1);
@@ -284,7 +290,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail17.json") {
     const auto string = R"(["Illegal backslash escape: \017"])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 29);
     REQUIRE(issues.size() == 1);
@@ -295,17 +301,17 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail18.json") {
     const auto string = R"([[[[[[[[[[[[[[[[[[[["Too deep"]]]]]]]]]]]]]]]]]]]])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Success);
     CHECK(parsedSize == string.size());
     CHECK(issues.empty());
-    // we do not explicitly impose limits on nesting depth
+    // the default nesting depth limit (ParsingOptions::maxDepth) is well above 20
   }
 
   SECTION("fail19.json") {
     const auto string = R"({"Missing colon" null})"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 17);
     REQUIRE(issues.size() == 1);
@@ -316,7 +322,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail20.json") {
     const auto string = R"({"Double colon":: null})"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 16);
     REQUIRE(issues.size() == 1);
@@ -327,7 +333,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail21.json") {
     const auto string = R"({"Comma instead of colon", null})"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 25);
     REQUIRE(issues.size() == 1);
@@ -338,7 +344,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail22.json") {
     const auto string = R"(["Colon instead of comma": false])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 25);
     REQUIRE(issues.size() == 1);
@@ -349,7 +355,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail23.json") {
     const auto string = R"(["Bad value", truth])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 17);
     REQUIRE(issues.size() == 1);
@@ -360,7 +366,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail24.json") {
     const auto string = "['single quote']"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 1);
     REQUIRE(issues.size() == 1);
@@ -371,7 +377,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail25.json") {
     const auto string = "[\"\ttab\tcharacter\tin\tstring\t\"]"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 2);
     REQUIRE(issues.size() == 1);
@@ -382,7 +388,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
   SECTION("fail26.json") {
     const auto string = R"(["tab\   character\   in\  string\  "])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 6);
     REQUIRE(issues.size() == 1);
@@ -394,7 +400,7 @@ TEST_CASE("JSON.org suite: fail", "[parse][JSON.org][fail]") {
     const auto string = R"(["line
 break"])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 6);
     REQUIRE(issues.size() == 1);
@@ -406,7 +412,7 @@ break"])"sv;
     const auto string = R"(["line\
 break"])"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 7);
     REQUIRE(issues.size() == 1);
@@ -417,7 +423,7 @@ break"])"sv;
   SECTION("fail29.json") {
     const auto string = "[0e]"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 3);
     REQUIRE(issues.size() == 1);
@@ -428,7 +434,7 @@ break"])"sv;
   SECTION("fail30.json") {
     const auto string = "[0e+]"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 4);
     REQUIRE(issues.size() == 1);
@@ -439,7 +445,7 @@ break"])"sv;
   SECTION("fail31.json") {
     const auto string = "[0e+-1]"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 4);
     REQUIRE(issues.size() == 1);
@@ -450,7 +456,7 @@ break"])"sv;
   SECTION("fail32.json") {
     const auto string = R"({"Comma instead if closing brace": true,)"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == string.size());
     REQUIRE(issues.size() == 1);
@@ -461,7 +467,7 @@ break"])"sv;
   SECTION("fail33.json") {
     const auto string = R"(["mismatch"})"sv;
 
-    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
     CHECK(status == minjson::ParsingResultStatus::Failure);
     CHECK(parsedSize == 11);
     REQUIRE(issues.size() == 1);
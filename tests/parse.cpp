@@ -1,6 +1,12 @@
 #include <climits>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <thread>
 
 #include <minjsoncpp.h>
+#include <minjsoncpp_ndjson.h>
 
 #include "utils.h"
 
@@ -230,6 +236,10 @@ TEST_CASE("parse numbers", "[parse]") {
     using pair = std::pair<std::string_view, int64_t>;
     const auto [string, expectedInteger] =
       GENERATE(pair{ "[0]"sv, 0 }, pair{ "[-0]"sv, 0 }, pair{ "[1]"sv, 1 }, pair{ "[-1]"sv, -1 },
+               pair{ "[12345678]"sv, 12345678 }, pair{ "[-123456789]"sv, -123456789 },
+               pair{ "[9876543210987654]"sv, 9876543210987654ll }, pair{ "[10000000000000000]"sv, 10000000000000000ll },
+               pair{ "[1234567890123456789]"sv, 1234567890123456789ll },
+               pair{ "[-1000000000000000000]"sv, -1000000000000000000ll },
                pair{ "[9223372036854775807]"sv, 9223372036854775807ll },  // max in64_t value
                pair{ "[-9223372036854775808]"sv, LLONG_MIN }              // min in64_t value
       );
@@ -291,9 +301,37 @@ TEST_CASE("parse numbers", "[parse]") {
     CHECK(array[0].asDouble() == expectedDecimal);
   }
 
+  SECTION("correctly rounded decimal numbers") {
+    const auto [string, expectedDecimal] =
+      GENERATE(pair{ "[0.1]"sv, 0.1 }, pair{ "[-65.613616999999977]"sv, -65.613616999999977 },
+               pair{ "[1e23]"sv, 1e23 }, pair{ "[123456789012345678e-40]"sv, 123456789012345678e-40 },
+               pair{ "[9007199254740993.0]"sv, 9007199254740992. }, // exactly halfway, rounds to even
+               pair{ "[9007199254740995.0]"sv, 9007199254740996. }, // exactly halfway, rounds to even
+               pair{ "[7.2057594037927933e16]"sv, 7.2057594037927933e16 },
+               pair{ "[2.2250738585072014e-308]"sv, 2.2250738585072014e-308 }, // min normal
+               pair{ "[2.2250738585072011e-308]"sv, 2.2250738585072011e-308 }, // max subnormal
+               pair{ "[4.9e-324]"sv, 4.9e-324 },                               // min subnormal
+               pair{ "[1.7976931348623157e308]"sv, 1.7976931348623157e308 },   // max
+               pair{ "[0.000000000000000000000000000000000000000000001e45]"sv, 1. },
+               pair{ "[3.14159265358979323846264338327950288]"sv, 3.14159265358979323846264338327950288 });
+    CAPTURE(string);
+
+    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    INFO(PrintIssues{ issues });
+    CHECK(status == minjson::ParsingResultStatus::Success);
+    CHECK(parsedSize == string.size());
+    CHECK(issues.empty());
+    REQUIRE(value.isArray());
+    const auto &array = value.asArray();
+    REQUIRE(array.size() == 1);
+    REQUIRE(array[0].isDouble());
+    CHECK(array[0].asDouble() == expectedDecimal);
+  }
+
   SECTION("large integers beyond in64_t range") {
     const auto string = GENERATE("[9223372036854775808]"sv,  // max in64_t value + 1
-                                 "[-9223372036854775809]"sv  // min in64_t value - 1
+                                 "[-9223372036854775809]"sv,  // min in64_t value - 1
+                                 "[9999999999999999999]"sv, "[-18446744073709551616]"sv, "[123456789012345678901234567890]"sv
     );
     CAPTURE(string);
 
@@ -310,6 +348,48 @@ TEST_CASE("parse numbers", "[parse]") {
 }
 
 
+#if !defined(_LIBCPP_VERSION) || _LIBCPP_VERSION >= 200100
+TEST_CASE("parse decimal numbers same as std::from_chars()", "[parse]") {
+  std::mt19937_64 random{ 42 };
+  char buf[64];
+  const auto check = [&](const char *end) {
+    const std::string_view string{ buf, static_cast<size_t>(end - buf) };
+    CAPTURE(string);
+    double expectedDecimal;
+    REQUIRE(std::from_chars(string.data(), end, expectedDecimal).ec == std::errc{});
+
+    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    INFO(PrintIssues{ issues });
+    REQUIRE(status == minjson::ParsingResultStatus::Success);
+    REQUIRE(value.isDouble());
+    const double decimal = value.asDouble();
+    REQUIRE(std::memcmp(&decimal, &expectedDecimal, sizeof(double)) == 0); // bitwise, including sign of zero
+  };
+
+  for (int n = 0; n < 100'000; ++n) {
+    uint64_t bits = random();
+    double d;
+    std::memcpy(&d, &bits, sizeof(d));
+    if (!std::isfinite(d))
+      continue;
+    // shortest round trip representation, and representations with more and fewer significant digits
+    for (const int precision : { -1, 14, 16, 18 }) {
+      const auto [end, ec] = precision < 0 ? std::to_chars(buf, buf + sizeof(buf), d, std::chars_format::scientific)
+                                           : std::to_chars(buf, buf + sizeof(buf), d, std::chars_format::scientific,
+                                                           precision);
+      REQUIRE(ec == std::errc{});
+      check(end);
+    }
+    // odd 54 bit significands are exactly halfway between two adjacent doubles (scaled by a power of 10 here)
+    const uint64_t significand = (bits >> 11) | (uint64_t{ 1 } << 53) | 1;
+    char *end = std::to_chars(buf, buf + sizeof(buf), significand).ptr;
+    end = std::strcpy(end, ".0e") + 3;
+    check(std::to_chars(end, buf + sizeof(buf), static_cast<int>(random() % 10)).ptr);
+  }
+}
+#endif
+
+
 TEST_CASE("parse large integers beyond in64_t range", "[parse][!mayfail]") {
   using pair = std::pair<std::string_view, double>;
   const auto [string, expectedDecimalNumber] = GENERATE(
@@ -589,3 +669,866 @@ TEST_CASE("parse garbage after valid value", "[parse]") {
     CHECK(issues.empty());
   }
 }
+
+
+TEST_CASE("parse long strings", "[parse]") {
+  const auto position = GENERATE(range(size_t{ 0 }, size_t{ 70 }));  // covers several vector sized chunks
+  const std::string prefix(position, 'a');
+  const std::string suffix(70 - position, 'b');
+
+  SECTION("without escapes") {
+    const auto string = getQuoted(prefix + suffix);
+    CAPTURE(string);
+
+    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    INFO(PrintIssues{ issues });
+    CHECK(status == minjson::ParsingResultStatus::Success);
+    CHECK(value == minjson::Value{ prefix + suffix });
+    CHECK(parsedSize == string.size());
+  }
+
+  SECTION("with escape") {
+    const auto string = getQuoted(prefix + R"(\n)"sv + suffix);
+    CAPTURE(string);
+
+    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    INFO(PrintIssues{ issues });
+    CHECK(status == minjson::ParsingResultStatus::Success);
+    CHECK(value == minjson::Value{ prefix + "\n"sv + suffix });
+    CHECK(parsedSize == string.size());
+  }
+
+  SECTION("with control character") {
+    const auto string = getQuoted(prefix + "\x1f"sv + suffix);
+    CAPTURE(string);
+
+    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    INFO(PrintIssues{ issues });
+    CHECK(status == minjson::ParsingResultStatus::Failure);
+    REQUIRE(issues.size() == 1);
+    CHECK(issues[0].code == minjson::ParsingIssue::Code::InvalidCharacter);
+    CHECK(issues[0].offset == position + 1);
+  }
+
+  SECTION("unterminated") {
+    const auto string = "\""sv + prefix;
+    CAPTURE(string);
+
+    const auto [value, status, parsedSize, issues] = minjson::parse(string);
+    INFO(PrintIssues{ issues });
+    CHECK(status == minjson::ParsingResultStatus::Failure);
+    REQUIRE(issues.size() == 1);
+    CHECK(issues[0].code == minjson::ParsingIssue::Code::UnexpectedEndOfInput);
+    CHECK(issues[0].offset == string.size());
+  }
+}
+
+
+TEST_CASE("parse strings validating UTF-8", "[parse][invalid utf8]") {
+  minjson::ParsingOptions options;
+  options.validation = minjson::Utf8Validation::FailOnInvalidUtf8CodeUnits;
+  options.engine = GENERATE(minjson::ParsingOptions::Engine::Default, minjson::ParsingOptions::Engine::StructuralIndex);
+
+  SECTION("valid") {
+    const auto string =
+      R"({ "pound sign \u00a3 £": "euro sign \u20ac €, emoji \ud83d\ude00 😀" })"sv;
+    CAPTURE(string);
+
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
+    INFO(PrintIssues{ issues });
+    CHECK(status == minjson::ParsingResultStatus::Success);
+    CHECK(value == minjson::Object{ { "pound sign \xC2\xA3 \xC2\xA3",
+                                      "euro sign \xE2\x82\xAC \xE2\x82\xAC, emoji \xF0\x9F\x98\x80 \xF0\x9F\x98\x80" } });
+    CHECK(parsedSize == string.size());
+  }
+
+  SECTION("invalid") {
+    const auto [string, offset] = GENERATE(std::pair{ "[\"pound sign \xC2 character\"]"sv, size_t{ 13 } },
+                                           std::pair{ "{\"euro sign \xE2\x82\\t\": 0}"sv, size_t{ 12 } },
+                                           std::pair{ "[\"\\n\x80\"]"sv, size_t{ 4 } });
+    CAPTURE(NonPrintStr{ string });
+
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
+    INFO(PrintIssues{ issues });
+    CHECK(status == minjson::ParsingResultStatus::Failure);
+    CHECK(parsedSize == offset);
+    REQUIRE(issues.size() == 1);
+    CHECK(issues[0].code == minjson::ParsingIssue::Code::StringContainsInvalidUtf8CodeUnits);
+    CHECK(issues[0].offset == offset);
+
+    CHECK(minjson::parse(string).status == minjson::ParsingResultStatus::Success);
+  }
+}
+
+
+TEST_CASE("parse using structural index engine", "[parse]") {
+  minjson::ParsingOptions options;
+  options.engine = minjson::ParsingOptions::Engine::StructuralIndex;
+
+  // clang-format off
+  const auto json = GENERATE(
+    R"({ "key": "value", "array": [ 1, -2.5e3, true, false, null, "" ], "nested": { "a": [], "b": {} } })"sv,
+    R"([ "escapes \" \\ \/ \b \f \n \r \t é 😀", "\\", "\\\\\"", "\"\\" ])"sv,
+    R"(["string containing structural characters {}[],: and whitespaces   ", "long string without escapes that )"
+    R"(spans more than one 64 byte block of the input, long string without escapes that spans more than one block"])"sv,
+    R"(["long string with escapes that spans more than one 64 byte block of the input \\\\\\\\\\\\\\\\\\\\\\\\\\\\"])"sv,
+    "[\"control \x01 character\"]"sv,
+    R"({ "unterminated": "string )"sv,
+    R"([ "escaped quotation mark at the end\" ])"sv,
+    R"([ "a" "b" ])"sv,
+    R"([ "a"x ])"sv,
+    R"([ 1 2 ])"sv,
+    R"([ 12x ])"sv,
+    R"({ "a": tru })"sv);
+  // clang-format on
+  const auto padding = GENERATE(range(size_t{ 0 }, size_t{ 66 }));  // shifts input across 64 byte block boundaries
+  const auto string = std::string(padding, ' ') + json;
+  CAPTURE(string);
+
+  const auto expected = minjson::parse(string);
+  const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
+  INFO(PrintIssues{ issues });
+  CHECK(status == expected.status);
+  CHECK(value == expected.value);
+  CHECK(parsedSize == expected.parsedSize);
+  REQUIRE(issues.size() == expected.issues.size());
+  for (size_t k = 0; k < issues.size(); ++k) {
+    CHECK(issues[k].code == expected.issues[k].code);
+    CHECK(issues[k].offset == expected.issues[k].offset);
+  }
+}
+
+
+TEST_CASE("parse without copying strings", "[parse]") {
+  minjson::ParsingOptions options;
+  options.engine = GENERATE(minjson::ParsingOptions::Engine::Default, minjson::ParsingOptions::Engine::StructuralIndex);
+
+  const auto string = R"({ "plain key": "plain value", "escaped\tkey": [ "escaped \"value\"", "", "\u00e9" ] })"sv;
+  const auto isBorrowed = [&string](const minjson::ZeroCopyValue::String &s) {
+    return s.isBorrowed() && string.data() <= s.data() && s.data() + s.size() <= string.data() + string.size();
+  };
+
+  const auto [value, status, parsedSize, issues] = minjson::parseZeroCopy(string, options);
+  INFO(PrintIssues{ issues });
+  REQUIRE(status == minjson::ParsingResultStatus::Success);
+  CHECK(parsedSize == string.size());
+  CHECK(minjson::serializeToString(value) == minjson::serializeToString(minjson::parse(string).value));
+
+  const auto &object = value.asObject();
+  REQUIRE(object.size() == 2);
+  const auto plain = object.find("plain key");
+  REQUIRE(plain != object.end());
+  CHECK(isBorrowed(plain->first));
+  CHECK(isBorrowed(plain->second.asString()));
+  CHECK(plain->second.asString() == "plain value");
+
+  const auto escaped = object.find("escaped\tkey");
+  REQUIRE(escaped != object.end());
+  CHECK_FALSE(escaped->first.isBorrowed());
+  const auto &array = escaped->second.asArray();
+  REQUIRE(array.size() == 3);
+  CHECK_FALSE(array[0].asString().isBorrowed());
+  CHECK(array[0].asString() == "escaped \"value\"");
+  CHECK(isBorrowed(array[1].asString()));
+  CHECK(array[1].asString().empty());
+  CHECK_FALSE(array[2].asString().isBorrowed());
+  CHECK(array[2].asString() == "\xC3\xA9");
+
+  SECTION("modified strings own their characters") {
+    minjson::ZeroCopyValue copy = plain->second;
+    copy.asString() += "!";
+    CHECK_FALSE(copy.asString().isBorrowed());
+    CHECK(copy.asString() == "plain value!");
+    CHECK(plain->second.asString() == "plain value");
+  }
+}
+
+
+TEST_CASE("parse in situ", "[parse]") {
+  minjson::ParsingOptions options;
+  options.engine = GENERATE(minjson::ParsingOptions::Engine::Default, minjson::ParsingOptions::Engine::StructuralIndex);
+  options.validation = GENERATE(minjson::Utf8Validation::IgnoreInvalidUtf8CodeUnits,
+                                minjson::Utf8Validation::FailOnInvalidUtf8CodeUnits);
+  options.replaceInvalidUtf16Surrogates = GENERATE(false, true);
+
+  // clang-format off
+  const auto string = GENERATE(
+    R"({ "plain key": "plain value", "escaped\tkey": [ "escaped \"value\"", "", "\u00e9", "\\\\\\" ] })"sv,
+    R"([ "surrogates \ud83d\ude00 \ud83d \ude00 \ud83d\n \ud83d\ud83d\ude00 \u20ac", 1, true, null ])"sv,
+    R"(["long string with escapes that spans more than one 64 byte block of the input \\\\\\\\\\\\\\\\\\\\\\\\\\\\"])"sv,
+    "[\"invalid \xC2 \\n UTF-8 \\t\"]"sv,
+    "[\"escape \\n then invalid \xE2\x82 UTF-8\"]"sv,
+    R"([ "unterminated \n string )"sv,
+    R"([ "a\"b" ] garbage)"sv);
+  // clang-format on
+  CAPTURE(NonPrintStr{ string });
+
+  const auto expected = minjson::parse(string, options);
+  std::string buffer{ string };
+  const auto [value, status, parsedSize, issues] = minjson::parseInSitu(buffer.data(), buffer.size(), options);
+  INFO(PrintIssues{ issues });
+  CHECK(status == expected.status);
+  CHECK(parsedSize == expected.parsedSize);
+  REQUIRE(issues.size() == expected.issues.size());
+  for (size_t k = 0; k < issues.size(); ++k) {
+    CHECK(issues[k].code == expected.issues[k].code);
+    CHECK(issues[k].offset == expected.issues[k].offset);
+  }
+  if (status != minjson::ParsingResultStatus::Failure) {
+    CHECK(minjson::serializeToString(value) == minjson::serializeToString(expected.value));
+    minjson::visit([&buffer](const auto &v) {
+      if constexpr (std::is_same_v<std::decay_t<decltype(v)>, minjson::ZeroCopyValue::Array>) {
+        for (const auto &e : v) {
+          if (e.isString()) {
+            CHECK(e.asString().isBorrowed());
+            CHECK(buffer.data() <= e.asString().data());
+            CHECK(e.asString().data() + e.asString().size() <= buffer.data() + buffer.size());
+          }
+        }
+      }
+    }, value);
+  }
+}
+
+namespace {
+  // writes compact JSON from events, members are written in the order they are parsed
+  struct WritingHandler {
+    void null() { write(minjson::Null{}); }
+    void boolean(bool b) { write(b); }
+    void integer(int64_t i) { write(i); }
+    void decimal(double d) { write(d); }
+    void string(std::string_view s) { write(s); }
+    void startArray() { open('['); }
+    void endArray() { close(']'); }
+    void startObject() { open('{'); }
+    void key(std::string_view k) {
+      write(k);
+      out += ':';
+      isKey = true;
+    }
+    void endObject() { close('}'); }
+
+    void open(char c) {
+      separate();
+      out += c;
+      isFirst = true;
+    }
+    void close(char c) {
+      out += c;
+      isFirst = false;
+    }
+    void separate() {
+      if (!isFirst && !isKey)
+        out += ',';
+      isFirst = false;
+      isKey = false;
+    }
+    void write(const minjson::Value &v) {
+      separate();
+      out += minjson::serializeToString(v);
+    }
+
+    std::string out;
+    bool isFirst = true;
+    bool isKey = false;
+  };
+}
+
+
+TEST_CASE("parse with SAX handler", "[parse][sax]") {
+  minjson::ParsingOptions options;
+  options.engine = GENERATE(minjson::ParsingOptions::Engine::Default, minjson::ParsingOptions::Engine::StructuralIndex);
+  options.duplicateObjectKeys = GENERATE(minjson::ParsingOptions::Option::Fail,
+                                         minjson::ParsingOptions::Option::Report,
+                                         minjson::ParsingOptions::Option::Ignore);
+
+  // clang-format off
+  const auto string = GENERATE(
+    R"({ "plain key": "plain value", "escaped\tkey": [ "escaped \"value\"", "", "é", -1, 3.5, 1e300 ] })"sv,
+    R"([ { "a": { "a": 1, "b": [] }, "b": {}, "c": [ [ true, false ], null ] }, 0, -0.0 ])"sv,
+    R"({ "a": 1, "b": { "a": 2, "b": 3 }, "a": 4 })"sv,
+    R"({ "": 1, "": 2 })"sv,
+    R"({ "k0": 0, "k1": 1, "k2": 2, "k3": 3, "k4": 4, "k5": 5, "k6": 6, "k7": 7, "k8": 8, "k9": 9, "k10": 10,
+         "k11": 11, "k12": 12, "k13": 13, "k14": 14, "k15": 15, "k16": 16, "k17": 17, "k18": 18, "k3": 19 })"sv,
+    "[\"invalid \xC2 UTF-8\"]"sv,
+    R"([ "unterminated \n string )"sv,
+    R"({ "a": [ 1, 2 } ])"sv,
+    R"("string" garbage)"sv);
+  // clang-format on
+  CAPTURE(string);
+
+  const auto expected = minjson::parse<std::allocator<char>, minjson::FlatObjectValuePolicy>(string, options);
+  WritingHandler handler;
+  const auto [status, parsedSize, issues] = minjson::parseSax(string, handler, options);
+  INFO(PrintIssues{ issues });
+  CHECK(status == expected.status);
+  CHECK(parsedSize == expected.parsedSize);
+  REQUIRE(issues.size() == expected.issues.size());
+  for (size_t k = 0; k < issues.size(); ++k) {
+    CHECK(issues[k].code == expected.issues[k].code);
+    CHECK(issues[k].offset == expected.issues[k].offset);
+  }
+  if (status == minjson::ParsingResultStatus::Success &&
+      options.duplicateObjectKeys == minjson::ParsingOptions::Option::Fail)
+    CHECK(handler.out == minjson::serializeToString(expected.value));
+}
+
+
+TEST_CASE("parse with SAX handler passing all members with duplicate keys", "[parse][sax]") {
+  minjson::ParsingOptions options;
+  options.duplicateObjectKeys = minjson::ParsingOptions::Option::Ignore;
+  WritingHandler handler;
+  const auto [status, parsedSize, issues] = minjson::parseSax(R"({ "a": 1, "b": { "a": 2 }, "a": 3 })", handler, options);
+  INFO(PrintIssues{ issues });
+  CHECK(status == minjson::ParsingResultStatus::Success);
+  CHECK(handler.out == R"({"a":1,"b":{"a":2},"a":3})");
+}
+
+
+TEST_CASE("extract values designated by JSON Pointers", "[parse][json pointer]") {
+  const minjson::JsonPointerSet pointers{
+    "/foo/1", "/foo/0/a", "/bar", "/escaped\tkey", "/foo/0/a", "/missing", "/foo/3", "", "/num/0", "/a~1b"
+  };
+  const auto input = R"({ "foo": [ { "a": "x\"y", "b": [ 1 ] }, [ true, null ] ], "bar": -1.5e3 ,
+                          "escaped\tkey": { "nested": {} }, "num": 42, "a/b": "\u00e9" })"sv;
+  minjson::ParsingOptions options;
+  options.engine = GENERATE(minjson::ParsingOptions::Engine::Default, minjson::ParsingOptions::Engine::StructuralIndex);
+
+  const auto [values, status, parsedSize, issues] = minjson::extract(input, pointers, options);
+  INFO(PrintIssues{ issues });
+  REQUIRE(status == minjson::ParsingResultStatus::Success);
+  CHECK(parsedSize == input.size());
+  const std::vector<std::string_view> expected{
+    "[ true, null ]"sv, R"("x\"y")"sv, "-1.5e3"sv, R"({ "nested": {} })"sv, R"("x\"y")"sv, ""sv, ""sv, input, ""sv,
+    R"("\u00e9")"sv
+  };
+  CHECK(std::vector<std::string_view>(values.begin(), values.end()) == expected);
+
+  // same values as resolved after parsing
+  const auto value = minjson::parse(input).value;
+  const auto resolved = pointers.resolve(value);
+  REQUIRE(resolved.size() == values.size());
+  for (size_t k = 0; k < values.size(); ++k) {
+    CAPTURE(k);
+    REQUIRE((resolved[k] != nullptr) == !values[k].empty());
+    if (resolved[k])
+      CHECK(*resolved[k] == minjson::parse(values[k]).value);
+  }
+
+  SECTION("invalid JSON") {
+    const auto result = minjson::extract(R"({ "foo": [ 1, 2 ], "bar": [ 1 2 ] })"sv, pointers, options);
+    CHECK(result.status == minjson::ParsingResultStatus::Failure);
+    CHECK(result.parsedSize == 30);
+    CHECK(result.values[0] == "2"sv); // values located before the error are kept
+    CHECK(result.values[2].empty());
+    CHECK(minjson::extract("{ \"foo\": \"invalid \xC2 UTF-8\" }"sv, pointers).status ==
+          minjson::ParsingResultStatus::Success);
+    minjson::ParsingOptions validating;
+    validating.validation = minjson::Utf8Validation::FailOnInvalidUtf8CodeUnits;
+    CHECK(minjson::extract("{ \"foo\": \"invalid \xC2 UTF-8\" }"sv, pointers, validating).status ==
+          minjson::ParsingResultStatus::Failure);
+    CHECK(minjson::extract("[ 1 ] 2"sv, pointers).status == minjson::ParsingResultStatus::PartialSuccess);
+  }
+  SECTION("duplicate keys") {
+    options.duplicateObjectKeys = GENERATE(minjson::ParsingOptions::Option::Fail,
+                                           minjson::ParsingOptions::Option::Report,
+                                           minjson::ParsingOptions::Option::Ignore);
+    // clang-format off
+    const auto string = GENERATE(
+      R"({ "bar": 1, "bar": 2 })"sv,
+      R"({ "x": 1, "x": 2 })"sv,
+      R"({ "bar": 1, "x": { "a": 1, "\u0061": 2 }, "y": { "a": 1 } })"sv,
+      R"({ "foo": [ { "a": 1, "b": 2, "a": 3 } ] })"sv,
+      R"({ "bar": 1, "x": [ { "": 1, "": 2 } ] })"sv,
+      R"({ "bar": 1, "x": { "k0": 0, "k1": 1, "k2": 2, "k3": 3, "k4": 4, "k5": 5, "k6": 6, "k7": 7, "k8": 8, "k9": 9,
+           "k10": 10, "k11": 11, "k12": 12, "k13": 13, "k14": 14, "k15": 15, "k16": 16, "k17": 17, "k3": 19 } })"sv,
+      R"({ "bar": 1, "x": { "a": { "b": 1 }, "b": { "b": 2 } } })"sv);
+    // clang-format on
+    CAPTURE(string, options.duplicateObjectKeys);
+
+    const auto expected = minjson::parse(string, options);
+    const auto result = minjson::extract(string, pointers, options);
+    INFO(PrintIssues{ result.issues });
+    CHECK(result.status == expected.status);
+    CHECK(result.parsedSize == expected.parsedSize);
+    REQUIRE(result.issues.size() == expected.issues.size());
+    for (size_t k = 0; k < result.issues.size(); ++k) {
+      CHECK(result.issues[k].code == expected.issues[k].code);
+      CHECK(result.issues[k].offset == expected.issues[k].offset);
+    }
+    if (string == R"({ "bar": 1, "bar": 2 })"sv && result.status != minjson::ParsingResultStatus::Failure)
+      CHECK(result.values[2] == "2"sv); // a member with a duplicate key replaces the previous one
+  }
+}
+
+
+TEMPLATE_TEST_CASE("parse projection", "[parse][json pointer]",
+                   minjson::DefaultValuePolicy, minjson::ZeroCopyValuePolicy, minjson::InternedKeysValuePolicy,
+                   minjson::CompactStringValuePolicy, minjson::FlatObjectValuePolicy) {
+  using Value = minjson::BasicValue<std::allocator<char>, TestType>;
+  const auto input = R"({ "id": 42, "user": { "name": "Alice", "tags": [ "a", "b" ], "escaped\tkey": "\u00e9" },
+                          "events": [ { "type": "x", "payload": { "big": [ 1, 2, 3 ] } }, { "type": "y" }, 5 ],
+                          "ignored": { "deeply": [ { "nested": "value" } ] } })"sv;
+  const minjson::JsonPointerSet projection{
+    "/id", "/user/name", "/user/escaped\tkey", "/events/1/type", "/user/name", "/missing", "/events/0/payload"
+  };
+  minjson::ParsingOptions options;
+  options.engine = GENERATE(minjson::ParsingOptions::Engine::Default, minjson::ParsingOptions::Engine::StructuralIndex);
+
+  const auto [value, status, parsedSize, issues] =
+    minjson::parseProjected<std::allocator<char>, TestType>(input, projection, options);
+  INFO(PrintIssues{ issues });
+  REQUIRE(status == minjson::ParsingResultStatus::Success);
+  CHECK(parsedSize == input.size());
+  CHECK(value == minjson::parse<std::allocator<char>, TestType>(R"({ "id": 42, "user": { "name": "Alice", "escaped\tkey": "é" },
+    "events": [ { "payload": { "big": [ 1, 2, 3 ] } }, { "type": "y" }, null ] })"sv).value);
+
+  const auto full = minjson::parse<std::allocator<char>, TestType>(input).value;
+  const auto resolved = projection.resolve(value);
+  const auto expected = projection.resolve(full);
+  for (size_t k = 0; k < resolved.size(); ++k) {
+    CAPTURE(k);
+    REQUIRE((resolved[k] != nullptr) == (expected[k] != nullptr));
+    if (resolved[k])
+      CHECK(*resolved[k] == *expected[k]);
+  }
+
+  SECTION("whole value") {
+    CHECK(minjson::parseProjected<std::allocator<char>, TestType>(input, minjson::JsonPointerSet{ "", "/id" }).value ==
+          full);
+  }
+  SECTION("empty projection") {
+    CHECK(minjson::parseProjected<std::allocator<char>, TestType>(input, minjson::JsonPointerSet{}).value ==
+          Value{ typename Value::Object{} });
+  }
+  SECTION("skipped array elements are replaced with nulls") {
+    const auto result = minjson::parseProjected<std::allocator<char>, TestType>(
+      "[ [ 1 ], { \"a\": 2 }, [ 3, 4 ], 5 ]"sv, minjson::JsonPointerSet{ "/2/1" });
+    CHECK(result.value == minjson::parse<std::allocator<char>, TestType>("[ null, null, [ null, 4 ], null ]"sv).value);
+  }
+  SECTION("invalid JSON") {
+    CHECK(minjson::parseProjected(R"({ "id": 1, "ignored": [ 1 2 ] })"sv, projection).status ==
+          minjson::ParsingResultStatus::Failure);
+    CHECK(minjson::parseProjected(R"({ "id": 1, "ignored": "\uDC00" })"sv, projection, [] {
+            minjson::ParsingOptions o;
+            o.unpairedUtf16Surrogates = minjson::ParsingOptions::Option::Fail;
+            return o;
+          }()).status == minjson::ParsingResultStatus::Failure);
+  }
+  SECTION("duplicate keys are detected in skipped values too") {
+    options.duplicateObjectKeys = GENERATE(minjson::ParsingOptions::Option::Fail,
+                                           minjson::ParsingOptions::Option::Report,
+                                           minjson::ParsingOptions::Option::Ignore);
+    // clang-format off
+    const auto string = GENERATE(
+      R"({ "id": 1, "id": 2 })"sv,
+      R"({ "x": 1, "x": 2 })"sv,
+      R"({ "id": 1, "x": { "a": 1, "a": 2 } })"sv,
+      R"({ "id": 1, "x": { "a": 1, "\u0061": 2 }, "y": { "a": 1 } })"sv,
+      R"({ "user": { "name": "a", "x": 1, "name": "b", "x": 2 } })"sv,
+      R"({ "id": 1, "x": [ { "": 1, "": 2 } ] })"sv,
+      R"({ "id": 1, "x": { "k0": 0, "k1": 1, "k2": 2, "k3": 3, "k4": 4, "k5": 5, "k6": 6, "k7": 7, "k8": 8, "k9": 9,
+           "k10": 10, "k11": 11, "k12": 12, "k13": 13, "k14": 14, "k15": 15, "k16": 16, "k17": 17, "k3": 19 } })"sv,
+      R"({ "id": 1, "x": { "a": { "b": 1 }, "b": { "b": 2 } } })"sv);
+    // clang-format on
+    CAPTURE(string, options.duplicateObjectKeys);
+
+    const auto expected = minjson::parse(string, options);
+    const auto [projected, projectedStatus, projectedSize, projectedIssues] =
+      minjson::parseProjected<std::allocator<char>, TestType>(string, projection, options);
+    INFO(PrintIssues{ projectedIssues });
+    CHECK(projectedStatus == expected.status);
+    CHECK(projectedSize == expected.parsedSize);
+    REQUIRE(projectedIssues.size() == expected.issues.size());
+    for (size_t k = 0; k < projectedIssues.size(); ++k) {
+      CHECK(projectedIssues[k].code == expected.issues[k].code);
+      CHECK(projectedIssues[k].offset == expected.issues[k].offset);
+    }
+  }
+}
+
+
+TEST_CASE("parse with interned keys", "[parse][interning]") {
+  const auto input = R"([ { "name": "a", "id": 1, "name2": "é" },
+                          { "id": 2, "name": "b", "name2": "c" },
+                          { "nested": { "name": "d" } } ])"sv;
+  minjson::KeyDictionary dictionary;
+  minjson::ParsingOptions options;
+  options.keyDictionary = &dictionary;
+
+  const auto expected = minjson::parse(input).value;
+  const auto checkKeys = [&dictionary](const auto &value) {
+    for (const auto &element : value.asArray()) {
+      for (const auto &[key, member] : element.asObject()) {
+        CAPTURE(std::string_view{ key });
+        CHECK(key.isBorrowed());
+        CHECK(std::string_view{ key }.data() == dictionary.intern(key).data());
+      }
+    }
+  };
+
+  SECTION("keys borrow characters from the dictionary") {
+    const auto [value, status, parsedSize, issues] =
+      minjson::parse<std::allocator<char>, minjson::InternedKeysValuePolicy>(input, options);
+    REQUIRE(status == minjson::ParsingResultStatus::Success);
+    CHECK(dictionary.size() == 4);
+    checkKeys(value);
+    CHECK(toString(value) == toString(expected));
+    CHECK(value.resolve(1, dictionary.intern("name"))->asString() == "b");
+    CHECK(value.resolve(0, "name2")->asString() == "é");
+    CHECK(value.resolve(2, "nested", "name")->asString() == "d");
+
+    INFO("the same keys are not stored again");
+    const auto [other, otherStatus, otherParsedSize, otherIssues] =
+      minjson::parse<std::allocator<char>, minjson::InternedKeysValuePolicy>(input, options);
+    CHECK(dictionary.size() == 4);
+    checkKeys(other);
+    CHECK(other == value);
+  }
+
+  SECTION("zero-copy keys borrow characters from the dictionary instead of the input") {
+    std::string copy{ input };
+    const auto [value, status, parsedSize, issues] = minjson::parseZeroCopy(copy, options);
+    REQUIRE(status == minjson::ParsingResultStatus::Success);
+    checkKeys(value);
+    CHECK(value.resolve(1, "name")->asString().data() == copy.data() + copy.find("\"b\"") + 1);
+  }
+
+  SECTION("keys of the default policy are owned") {
+    const auto [value, status, parsedSize, issues] = minjson::parse(input, options);
+    REQUIRE(status == minjson::ParsingResultStatus::Success);
+    CHECK(dictionary.size() == 0);
+    CHECK(value == expected);
+  }
+
+  SECTION("keys are owned without a dictionary") {
+    const auto [value, status, parsedSize, issues] =
+      minjson::parse<std::allocator<char>, minjson::InternedKeysValuePolicy>(input);
+    REQUIRE(status == minjson::ParsingResultStatus::Success);
+    for (const auto &[key, member] : value.asArray()[0].asObject())
+      CHECK(!key.isBorrowed());
+    CHECK(toString(value) == toString(expected));
+  }
+
+  SECTION("empty keys borrow characters from the dictionary too") {
+    CHECK(dictionary.intern("").data() != nullptr);
+    CHECK(dictionary.intern("").data() == dictionary.intern("").data());
+    const auto [value, status, parsedSize, issues] =
+      minjson::parse<std::allocator<char>, minjson::InternedKeysValuePolicy>(R"([ { "": 1 }, { "": 2 } ])", options);
+    REQUIRE(status == minjson::ParsingResultStatus::Success);
+    for (const auto &object : value.asArray()) {
+      const auto &[key, member] = *object.asObject().begin();
+      CHECK(key.isBorrowed());
+      CHECK(std::string_view{ key }.data() == dictionary.intern("").data());
+    }
+  }
+
+  SECTION("concurrent parsers share the dictionary") {
+    std::string big = "[";
+    for (int i = 0; i < 2000; ++i)
+      big += (i ? ", " : "") + ("{ \"key" + std::to_string(i % 300) + "\": " + std::to_string(i) + " }");
+    big += "]";
+
+    std::vector<minjson::InternedKeysValue> values(4);
+    std::vector<std::thread> threads;
+    for (auto &value : values)
+      threads.emplace_back([&] {
+        value = minjson::parse<std::allocator<char>, minjson::InternedKeysValuePolicy>(big, options).value;
+      });
+    for (auto &thread : threads)
+      thread.join();
+
+    CHECK(dictionary.size() == 300);
+    for (const auto &value : values) {
+      REQUIRE(value.asArray().size() == 2000);
+      checkKeys(value);
+      CHECK(value == values[0]);
+    }
+  }
+}
+
+
+TEST_CASE("parse in chunks", "[parse][sax][streaming]") {
+  minjson::ParsingOptions options;
+  options.duplicateObjectKeys = GENERATE(minjson::ParsingOptions::Option::Fail,
+                                         minjson::ParsingOptions::Option::Report,
+                                         minjson::ParsingOptions::Option::Ignore);
+  options.unpairedUtf16Surrogates = minjson::ParsingOptions::Option::Report;
+  options.validation = minjson::Utf8Validation::FailOnInvalidUtf8CodeUnits;
+  const auto parsingMode = GENERATE(minjson::ParsingMode::VerifyTrailingWhitespace,
+                                    minjson::ParsingMode::StopAfterValueEnds);
+
+  // clang-format off
+  const auto string = GENERATE(
+    R"({ "plain key": "plain value", "escaped\tkey": [ "escaped \"value\"", "", "é", -1, 3.5e-3, true, false, null ] })"sv,
+    R"([ { "a": { "a": 1, "b": [] }, "b": {}, "c": [ [ true, false ], null ] }, 0, -0.0, "\ud83d\ude00 \ud83d" ] )"sv,
+    R"({ "a": 1, "b": { "a": 2, "b": 3 }, "a": 4 })"sv,
+    R"({ "": 1, "": 2 })"sv,
+    R"({ "k0": 0, "k1": 1, "k2": 2, "k3": 3, "k4": 4, "k5": 5, "k6": 6, "k7": 7, "k8": 8, "k9": 9, "k10": 10,
+         "k11": 11, "k12": 12, "k13": 13, "k14": 14, "k15": 15, "k16": 16, "k17": 17, "k18": 18, "k3": 19 })"sv,
+    "12345"sv, "  -3.25e+2  "sv, "\"\\\\\\\"\\u00e9\""sv, "true"sv, "nul"sv, "1.5.3"sv, "[ 1.5.3 ]"sv, "[truex]"sv,
+    ""sv, "  "sv, "[ 1, ]"sv, "[ 1 2 ]"sv, R"({ "a" 1 })"sv, R"({ "a": 1 "b": 2 })"sv, R"({ 1: 2 })"sv, R"({ "a": )"sv,
+    "[\"invalid \xC2 UTF-8\"]"sv, "[ \"control \n character\" ]"sv, R"([ "unterminated \n string )"sv,
+    R"({ "a": [ 1, 2 } ])"sv, R"("string" garbage)"sv, "{} \n {}"sv, "[ -, 1 ]"sv, "[ 1e999 ]"sv);
+  // clang-format on
+  CAPTURE(string);
+
+  WritingHandler expectedHandler;
+  const auto expected = minjson::parseSax(string, expectedHandler, options, parsingMode);
+  const size_t chunkSize = GENERATE(1, 2, 3, 5, 16, 1000);
+  CAPTURE(chunkSize);
+
+  SECTION("SAX") {
+    WritingHandler handler;
+    minjson::StreamingParser<WritingHandler> parser{ handler, options };
+    for (size_t k = 0; k < string.size(); k += chunkSize)
+      parser.feed(string.substr(k, chunkSize));
+    const auto [status, parsedSize, issues] = parser.finish(parsingMode);
+    INFO(PrintIssues{ issues });
+    CHECK(status == expected.status);
+    CHECK(parsedSize == expected.parsedSize);
+    REQUIRE(issues.size() == expected.issues.size());
+    for (size_t k = 0; k < issues.size(); ++k) {
+      CHECK(issues[k].code == expected.issues[k].code);
+      CHECK(issues[k].offset == expected.issues[k].offset);
+    }
+    if (status != minjson::ParsingResultStatus::Failure)
+      CHECK(handler.out == expectedHandler.out);
+  }
+
+  SECTION("DOM") {
+    minjson::ValueHandler handler;
+    minjson::StreamingParser<minjson::ValueHandler> parser{ handler, options };
+    for (size_t k = 0; k < string.size(); k += chunkSize)
+      parser.feed(string.substr(k, chunkSize));
+    const auto result = parser.finish(parsingMode);
+    const auto [value, status, parsedSize, issues] = minjson::parse(string, options, parsingMode);
+    CHECK(result.status == status);
+    CHECK(result.parsedSize == parsedSize);
+    CHECK(result.issues.size() == issues.size());
+    if (status != minjson::ParsingResultStatus::Failure)
+      CHECK(handler.value == value);
+  }
+}
+
+
+TEST_CASE("parse deeply nested input", "[parse][depth]") {
+  struct CountingHandler {
+    size_t count = 0;
+    void null() { ++count; }
+    void boolean(bool) { ++count; }
+    void integer(int64_t) { ++count; }
+    void decimal(double) { ++count; }
+    void string(std::string_view) { ++count; }
+    void startArray() { ++count; }
+    void endArray() {}
+    void startObject() { ++count; }
+    void key(std::string_view) {}
+    void endObject() {}
+  };
+
+  constexpr size_t depth = 100'000;
+  const bool objects = GENERATE(false, true);
+  std::string string;
+  for (size_t k = 0; k < depth; ++k)
+    string += objects ? R"({"a":)" : "[";
+  string += "1";
+  string.append(depth, objects ? '}' : ']');
+  const size_t openingSize = objects ? 5 : 1;
+
+  SECTION("default limit") {
+    const minjson::ParsingOptions options;
+    const size_t expectedOffset = options.maxDepth * openingSize;
+
+    const auto checkFailure = [&](minjson::ParsingResultStatus status,
+                                  size_t parsedSize,
+                                  const std::vector<minjson::ParsingIssue> &issues) {
+      CHECK(status == minjson::ParsingResultStatus::Failure);
+      CHECK(parsedSize == expectedOffset);
+      REQUIRE(issues.size() == 1);
+      CHECK(issues[0].code == minjson::ParsingIssue::Code::MaxDepthExceeded);
+      CHECK(issues[0].offset == expectedOffset);
+    };
+
+    {
+      const auto [value, status, parsedSize, issues] = minjson::parse(string, options);
+      checkFailure(status, parsedSize, issues);
+    }
+    {
+      const auto [document, status, parsedSize, issues] = minjson::parseDocument(string, options);
+      checkFailure(status, parsedSize, issues);
+    }
+    {
+      CountingHandler handler;
+      const auto [status, parsedSize, issues] = minjson::parseSax(string, handler, options);
+      checkFailure(status, parsedSize, issues);
+    }
+    {
+      CountingHandler handler;
+      minjson::StreamingParser<CountingHandler> parser{ handler, options };
+      for (size_t k = 0; k < string.size(); k += 4096)
+        parser.feed(std::string_view{ string }.substr(k, 4096));
+      const auto [status, parsedSize, issues] = parser.finish();
+      checkFailure(status, parsedSize, issues);
+    }
+  }
+
+  SECTION("raised limit") {
+    // built values are destroyed, copied, compared and serialized recursively,
+    // so deep nesting is checked using SAX handler only
+    minjson::ParsingOptions options;
+    options.maxDepth = depth;
+
+    {
+      CountingHandler handler;
+      const auto [status, parsedSize, issues] = minjson::parseSax(string, handler, options);
+      CHECK(status == minjson::ParsingResultStatus::Success);
+      CHECK(parsedSize == string.size());
+      CHECK(issues.empty());
+      CHECK(handler.count == depth + 1);
+    }
+    {
+      CountingHandler handler;
+      minjson::StreamingParser<CountingHandler> parser{ handler, options };
+      for (size_t k = 0; k < string.size(); k += 4096)
+        parser.feed(std::string_view{ string }.substr(k, 4096));
+      const auto [status, parsedSize, issues] = parser.finish();
+      CHECK(status == minjson::ParsingResultStatus::Success);
+      CHECK(handler.count == depth + 1);
+    }
+
+    options.maxDepth = depth - 1;
+    CountingHandler handler;
+    const auto [status, parsedSize, issues] = minjson::parseSax(string, handler, options);
+    CHECK(status == minjson::ParsingResultStatus::Failure);
+    REQUIRE(issues.size() == 1);
+    CHECK(issues[0].code == minjson::ParsingIssue::Code::MaxDepthExceeded);
+    CHECK(issues[0].offset == (depth - 1) * openingSize);
+  }
+
+  SECTION("raised limit building values") {
+    constexpr size_t valueDepth = 2 * minjson::ParsingOptions{}.maxDepth;
+    const size_t begin = (depth - valueDepth) * openingSize;
+    const auto input = std::string_view{ string }.substr(begin, string.size() - begin - (depth - valueDepth));
+    minjson::ParsingOptions options;
+    options.maxDepth = valueDepth;
+
+    {
+      const auto [value, status, parsedSize, issues] = minjson::parse(input, options);
+      CHECK(status == minjson::ParsingResultStatus::Success);
+      CHECK(parsedSize == input.size());
+      CHECK(issues.empty());
+      const minjson::Value *v = &value;
+      size_t levels = 0;
+      while (objects ? v->isObject() : v->isArray()) {
+        v = objects ? &v->asObject().at("a") : &v->asArray().front();
+        ++levels;
+      }
+      CHECK(levels == valueDepth);
+      CHECK(*v == 1);
+    }
+    {
+      const auto [document, status, parsedSize, issues] = minjson::parseDocument(input, options);
+      CHECK(status == minjson::ParsingResultStatus::Success);
+      CHECK(parsedSize == input.size());
+    }
+  }
+}
+
+
+TEST_CASE("parse NDJSON", "[parse][ndjson]") {
+  std::string input;
+  std::vector<size_t> lineOffsets;
+  for (size_t k = 0; k < 30000; ++k) {
+    lineOffsets.push_back(input.size());
+    switch (k % 7) {
+    case 0: input += R"({ "id": )" + std::to_string(k) + R"(, "name": "line A", "tags": [ "a", "b" ] })"; break;
+    case 1: input += "  [ 1, 2.5, true, null ]\r"; break;
+    case 2: input += R"("string")"; break;
+    case 3: input += k % 3 == 0 ? R"({ "invalid": ] })" : R"({ "valid": {} })"; break;
+    case 4: input += k % 5 == 0 ? "42 garbage" : "42"; break;
+    case 5: break; // empty line
+    case 6: input += " \t "; break;
+    }
+    input += '\n';
+  }
+  const size_t threadCount = GENERATE(0, 1, 2, 3);
+  CAPTURE(threadCount);
+
+  const auto values = minjson::parseNdjson(input, {}, threadCount);
+  size_t k = 0;
+  for (size_t line = 0; line < lineOffsets.size(); ++line) {
+    const size_t offset = lineOffsets[line];
+    const size_t lineEnd = input.find('\n', offset);
+    const auto expected = minjson::parse(std::string_view{ input }.substr(offset, lineEnd - offset));
+    if (line % 7 >= 5)
+      continue;
+    CAPTURE(line);
+    REQUIRE(k < values.size());
+    const auto &[valueLine, valueOffset, result] = values[k++];
+    CHECK(valueLine == line);
+    CHECK(valueOffset == offset);
+    CHECK(result.status == expected.status);
+    CHECK(result.parsedSize == expected.parsedSize + offset);
+    CHECK(result.value == expected.value);
+    REQUIRE(result.issues.size() == expected.issues.size());
+    for (size_t i = 0; i < result.issues.size(); ++i) {
+      CHECK(result.issues[i].code == expected.issues[i].code);
+      CHECK(result.issues[i].offset == expected.issues[i].offset + offset);
+    }
+  }
+  CHECK(k == values.size());
+
+  SECTION("exceptions thrown by callback") {
+    size_t count = 0;
+    CHECK_THROWS_AS(minjson::parseNdjson(input, [&count](minjson::NdjsonValue &&) {
+      if (++count == 1000)
+        throw std::runtime_error{ "stop" };
+    }, {}, threadCount), std::runtime_error);
+    CHECK(count == 1000);
+  }
+}
+
+
+TEST_CASE("parse file", "[parse][file]") {
+  const auto path = std::filesystem::temp_directory_path() /
+                    ("minjsoncpp_parse_file_test_" + std::to_string(std::random_device{}()) + ".json");  // unique per run
+  const auto write = [&path](std::string_view contents) {
+    std::ofstream file{ path, std::ios_base::binary | std::ios_base::trunc };
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+  };
+
+  SECTION("values") {
+    const auto string = GENERATE(R"({ "key": [ "value", 42, 3.14, true, null ] })"sv, R"([ 1, 2 ] garbage)"sv, "[ 1, "sv, ""sv);
+    CAPTURE(string);
+    write(string);
+
+    const auto expected = minjson::parse(string);
+    const auto [value, status, parsedSize, issues] = minjson::parseFile(path);
+    CHECK(status == expected.status);
+    CHECK(parsedSize == expected.parsedSize);
+    CHECK(issues.size() == expected.issues.size());
+    CHECK(value == expected.value);
+
+    const auto document = minjson::parseDocumentFile(path);
+    CHECK(document.status == expected.status);
+    CHECK(document.parsedSize == expected.parsedSize);
+    if (document.status != minjson::ParsingResultStatus::Failure)
+      CHECK(minjson::serializeToString(document.document) == minjson::serializeToString(expected.value));
+  }
+
+  SECTION("zero-copy values referring to mapped file") {
+    write(R"({ "key": "value" })");
+    const minjson::MappedFile file{ path };
+    const auto [value, status, parsedSize, issues] = minjson::parseZeroCopy(file);
+    REQUIRE(status == minjson::ParsingResultStatus::Success);
+    const auto &string = value.resolve("key")->asString();
+    CHECK(string == "value");
+    CHECK(string.isBorrowed());
+    CHECK(file.data() <= string.data());
+    CHECK(string.data() + string.size() <= file.data() + file.size());
+  }
+
+  std::filesystem::remove(path);
+  CHECK_THROWS_AS(minjson::parseFile(path), std::system_error);
+}
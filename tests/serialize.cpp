@@ -1,3 +1,9 @@
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <thread>
+
 #include <minjsoncpp.h>
 
 #include "utils.h"
@@ -42,6 +48,242 @@ TEST_CASE("serialize values", "[serialize]") {
 }
 
 
+TEST_CASE("serialize decimal numbers", "[serialize]") {
+  SECTION("shortest representation same as std::to_chars()") {
+    std::mt19937_64 random{ 42 };
+    const auto check = [](double d) {
+      char buf[32];
+      const auto end = std::to_chars(buf, buf + sizeof(buf), d).ptr;
+      const std::string_view expected{ buf, static_cast<size_t>(end - buf) };
+      CAPTURE(expected);
+      REQUIRE(minjson::serializeToString(minjson::Value{ d }) == expected);
+    };
+    for (const double d : { 0., -0., 1., -1., 0.1, 0.3, 1000., 1e22, 1e23, 9007199254740993., 123456789012345680000.,
+                            1e-5, 2.2250738585072014e-308, 1.7976931348623157e308, 4.9e-324, 1e-323 })
+      check(d);
+    for (int n = 0; n < 100'000; ++n) {
+      const uint64_t bits = random();
+      double d;
+      std::memcpy(&d, &bits, sizeof(d));
+      if (std::isfinite(d))
+        check(d);
+    }
+  }
+
+  SECTION("options") {
+    using Notation = minjson::SerializationOptions::DecimalOptions::Notation;
+    const auto serialize = [](double d, const auto &setOptions) {
+      minjson::SerializationOptions options;
+      setOptions(options.decimal);
+      return minjson::serializeToString(minjson::Value{ d }, options);
+    };
+    using Options = minjson::SerializationOptions::DecimalOptions;
+
+    CHECK(serialize(42., [](Options &) {}) == "42"sv);
+    CHECK(serialize(42., [](Options &o) { o.decimalPointForIntegral = true; }) == "42.0"sv);
+    CHECK(serialize(-0., [](Options &o) { o.decimalPointForIntegral = true; }) == "-0.0"sv);
+    CHECK(serialize(0.5, [](Options &o) { o.decimalPointForIntegral = true; }) == "0.5"sv);
+    CHECK(serialize(1e22, [](Options &o) { o.decimalPointForIntegral = true; }) == "1e+22"sv);
+
+    CHECK(serialize(1e22, [](Options &o) { o.exponentPlusSign = false; }) == "1e22"sv);
+    CHECK(serialize(1e-7, [](Options &o) { o.minExponentDigits = 1; }) == "1e-7"sv);
+    CHECK(serialize(1e-7, [](Options &o) { o.minExponentDigits = 3; }) == "1e-007"sv);
+    CHECK(serialize(1.5e300, [](Options &o) { o.minExponentDigits = 1; }) == "1.5e+300"sv);
+    CHECK(serialize(1e22, [](Options &o) { o.exponentChar = 'E'; }) == "1E+22"sv);
+
+    CHECK(serialize(1e22, [](Options &o) { o.notation = Notation::Fixed; }) == "10000000000000000000000"sv);
+    CHECK(serialize(1e-7, [](Options &o) { o.notation = Notation::Fixed; }) == "0.0000001"sv);
+    CHECK(serialize(-12.5, [](Options &o) { o.notation = Notation::Fixed; }) == "-12.5"sv);
+    CHECK(serialize(1e300, [](Options &o) { o.notation = Notation::Fixed; }) == "1" + std::string(300, '0'));
+    CHECK(serialize(-4.9e-324, [](Options &o) { o.notation = Notation::Fixed; }) == "-0." + std::string(323, '0') + '5');
+    CHECK(serialize(1e21, [](Options &o) { o.notation = Notation::Fixed; }) == "1000000000000000000000"sv);
+    // exactly, the same as printf("%.0f")
+    CHECK(serialize(1e23, [](Options &o) { o.notation = Notation::Fixed; }) == "99999999999999991611392"sv);
+    CHECK(serialize(123456789012345680000., [](Options &) {}) == "123456789012345683968"sv);
+
+    CHECK(serialize(0., [](Options &o) { o.notation = Notation::Scientific; }) == "0e+00"sv);
+    CHECK(serialize(1000., [](Options &o) { o.notation = Notation::Scientific; }) == "1e+03"sv);
+    CHECK(serialize(-12.5, [](Options &o) { o.notation = Notation::Scientific; }) == "-1.25e+01"sv);
+    CHECK(serialize(0.001, [](Options &o) { o.notation = Notation::Scientific; }) == "1e-03"sv);
+
+    CHECK(serialize(3.14159265358979, [](Options &o) { o.precision = 3; }) == "3.14"sv);
+    CHECK(serialize(-65.613616999999977, [](Options &o) { o.precision = 6; }) == "-65.6136"sv);
+    CHECK(serialize(0.5, [](Options &o) { o.precision = 6; }) == "0.5"sv);
+    CHECK(serialize(2.675, [](Options &o) { o.precision = 3; }) == "2.67"sv); // 2.67499999999999982236431605997495353221893310546875
+    CHECK(serialize(0.125, [](Options &o) { o.precision = 2; }) == "0.12"sv); // exactly halfway, to even
+    CHECK(serialize(999.96, [](Options &o) { o.precision = 4; }) == "1000"sv);
+    CHECK(serialize(123456789., [](Options &o) { o.precision = 3; }) == "1.23e+08"sv);
+    CHECK(serialize(123456789., [](Options &o) {
+            o.precision = 3;
+            o.notation = Notation::Fixed;
+          }) == "123000000"sv);
+    CHECK(serialize(0.1, [](Options &o) { o.precision = 100; }) == "0.10000000000000001"sv); // at most 17 digits
+  }
+}
+
+
+TEST_CASE("serialize with buffered sink", "[serialize]") {
+  minjson::Array array;
+  for (int i = 0; i < 1000; ++i)
+    array.emplace_back(minjson::Object{ { "integer", i }, { "decimal", i / 8. }, { "string", "foo\tbar" } });
+  array.emplace_back(std::string(3000, 'x')); // doesn't fit into the buffer
+  const minjson::Value value = std::move(array);
+  minjson::SerializationOptions options;
+  options.indent = 2;
+  const std::string expected = minjson::serializeToString(value, options);
+
+  std::string result;
+  size_t calls = 0;
+  const auto sink = [&](std::string_view s) {
+    ++calls;
+    result += s;
+  };
+
+  SECTION("default buffer") {
+    minjson::BufferedSink buffered{ sink };
+    minjson::impl::serialize(buffered, value, options);
+    buffered.flush();
+    CHECK(result == expected);
+    CHECK(calls <= expected.size() / (4 * 1024) + 2);
+  }
+
+  SECTION("small buffer") {
+    {
+      minjson::BufferedSink<decltype(sink) &, 1024> buffered{ sink };
+      minjson::impl::serialize(buffered, value, options);
+    } // flushed on destruction
+    CHECK(result == expected);
+    CHECK(calls <= expected.size() / 512 + 2);
+  }
+
+  SECTION("stream") {
+    std::ostringstream stream;
+    minjson::serializeToStream(stream, value, options);
+    CHECK(stream.str() == expected);
+  }
+
+#if defined(MINJSONCPP_POSIX)
+  SECTION("file descriptor") {
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    std::thread writer{ [&] {
+      {
+        minjson::BufferedSink buffered{ minjson::FileDescriptorSink{ fds[1] } };
+        minjson::impl::serialize(buffered, value, options);
+      }
+      ::close(fds[1]);
+    } };
+    char buf[4096];
+    for (ssize_t size; (size = ::read(fds[0], buf, sizeof(buf))) > 0;)
+      result.append(buf, static_cast<size_t>(size));
+    writer.join();
+    ::close(fds[0]);
+    CHECK(result == expected);
+  }
+#endif
+}
+
+
+namespace {
+size_t countedAllocations = 0;
+
+template<typename T>
+struct CountingAllocator {
+  using value_type = T;
+
+  CountingAllocator() = default;
+  template<typename U>
+  CountingAllocator(const CountingAllocator<U> &) {}
+
+  T *allocate(size_t n) {
+    ++countedAllocations;
+    return std::allocator<T>{}.allocate(n);
+  }
+  void deallocate(T *p, size_t n) {
+    std::allocator<T>{}.deallocate(p, n);
+  }
+
+  template<typename U>
+  bool operator==(const CountingAllocator<U> &) const {
+    return true;
+  }
+  template<typename U>
+  bool operator!=(const CountingAllocator<U> &) const {
+    return false;
+  }
+};
+
+using CountingString = std::basic_string<char, std::char_traits<char>, CountingAllocator<char>>;
+}  // namespace
+
+
+TEST_CASE("serialize with exact size", "[serialize]") {
+  const minjson::Value value = minjson::Object{
+    { "null", minjson::Null{} },
+    { "decimals", minjson::Array{ 0.1, -1e-7, 1e300, 42. } },
+    { "escapes", "tab\t, quote \", control \x01, non-ASCII \xD0\xAF" },
+    { "nested", minjson::Array{ minjson::Object{ { "integer", -42 } }, minjson::Array{}, minjson::Object{} } }
+  };
+  CAPTURE(value);
+
+  minjson::SerializationOptions options;
+  SECTION("default options") {}
+  SECTION("indentation") {
+    options.indent = 3;
+    options.newline.beforeObjectMemberCollectionValue = true;
+  }
+  SECTION("escape non-ASCII") {
+    options.escape = minjson::Escape::NonAscii;
+    options.hexDigitsCase = minjson::HexDigitsCase::Upper;
+  }
+  SECTION("decimal options") {
+    options.decimal.notation = minjson::SerializationOptions::DecimalOptions::Notation::Fixed;
+  }
+  const std::string expected = minjson::serializeToString(value, options);
+  CAPTURE(expected);
+
+  CHECK(minjson::serializedSize(value, options) == expected.size());
+
+  const std::string exactSize = minjson::serializeToString(value, options, minjson::StringAllocation::ExactSize);
+  CHECK(exactSize == expected);
+  CHECK(exactSize.capacity() == expected.size());
+
+  std::string buffer(expected.size() + 10, '#');
+  CHECK(minjson::serializeToBuffer(buffer.data(), buffer.size(), value, options) == expected.size());
+  CHECK(buffer == expected + std::string(10, '#'));
+
+  buffer.assign(expected.size(), '#');
+  const size_t truncatedSize = expected.size() / 2;
+  CHECK(minjson::serializeToBuffer(buffer.data(), truncatedSize, value, options) == expected.size());
+  CHECK(buffer == expected.substr(0, truncatedSize) + std::string(expected.size() - truncatedSize, '#'));
+
+  CHECK(minjson::serializeToBuffer(nullptr, 0, value, options) == expected.size());
+
+  {
+    INFO("value with counting allocator");
+    const auto counted = minjson::parse<CountingAllocator<char>>(expected).value;
+    countedAllocations = 0;
+    const CountingString string = minjson::serializeToString(counted, options, minjson::StringAllocation::ExactSize);
+    CHECK(string.size() == expected.size());  // member order may differ from the value above
+    CHECK(string.capacity() == expected.size());
+    CHECK(countedAllocations == 1);  // allocated once, never reallocated
+  }
+
+  {
+    INFO("document");
+    const auto [document, status, parsedSize, issues] = minjson::parseDocument(expected);
+    REQUIRE(status == minjson::ParsingResultStatus::Success);
+    CHECK(minjson::serializedSize(document, options) == expected.size());
+    countedAllocations = 0;
+    const auto string = minjson::serializeToString<CountingString>(document, options, minjson::StringAllocation::ExactSize);
+    CHECK(string == expected.c_str());
+    CHECK(string.capacity() == expected.size());
+    CHECK(countedAllocations == 1);
+    CHECK(minjson::serializeToBuffer(buffer.data(), buffer.size(), document, options) == expected.size());
+  }
+}
+
+
 TEST_CASE("serialization formatting: indentation", "[serialize][formatting]") {
   SECTION("default indentation options") {
     minjson::SerializationOptions options{ 5 };
@@ -1,7 +1,9 @@
 #include <minjsoncpp.h>
 
-template<typename A>
-std::ostream &operator<<(std::ostream &s, const minjson::BasicValue<A> &v) {
+#include <sstream>
+
+template<typename A, typename P>
+std::ostream &operator<<(std::ostream &s, const minjson::BasicValue<A, P> &v) {
   static constexpr auto options = /*std::invoke() is not contexpr until C++23*/ [] {
     minjson::SerializationOptions o;
     o.objectKeyValueSeparator = ": ";
@@ -14,6 +16,14 @@ std::ostream &operator<<(std::ostream &s, const minjson::BasicValue<A> &v) {
   return s;
 }
 
+// pretty printed with sorted keys, so values of different types may be compared
+template<typename A, typename P>
+std::string toString(const minjson::BasicValue<A, P> &v) {
+  std::ostringstream s;
+  s << v;
+  return s.str();
+}
+
 inline std::ostream &operator<<(std::ostream &s, minjson::ParsingResultStatus status) {
   switch (status) {
   case minjson::ParsingResultStatus::Failure:
@@ -450,3 +450,339 @@ TEST_CASE("resolve value", "[value][resolve]") {
     }
   }
 }
+
+
+TEMPLATE_TEST_CASE("resolve JSON Pointer", "[value][resolve][json pointer]",
+                   minjson::DefaultValuePolicy, minjson::ZeroCopyValuePolicy, minjson::InternedKeysValuePolicy,
+                   minjson::CompactStringValuePolicy, minjson::FlatObjectValuePolicy,
+                   minjson::SortedFlatObjectValuePolicy) {
+  using Value = minjson::BasicValue<std::allocator<char>, TestType>;
+
+  std::string input = R"({ "foo": [ "bar", "baz" ], "": 0, "a/b": 1, "c%d": 2, "e^f": 3, "g|h": 4, "i\\j": 5,
+                           "k\"l": 6, " ": 7, "m~n": 8, "01": { "0": [ null, { "x": true } ] })";
+  for (int i = 0; i < 100; ++i)
+    input += ", \"key" + std::to_string(i) + "\": " + std::to_string(i);
+  input += " }";
+  auto [value, status, parsedSize, issues] = minjson::parse<std::allocator<char>, TestType>(input);
+  INFO(PrintIssues{ issues });
+  REQUIRE(status == minjson::ParsingResultStatus::Success);
+
+  SECTION("RFC 6901 examples") {
+    CHECK(minjson::JsonPointer{ "" }.resolve(value) == &value);
+    CHECK(*minjson::JsonPointer{ "/foo" }.resolve(value) == *value.resolve("foo"));
+    CHECK(*minjson::JsonPointer{ "/foo/0" }.resolve(value) == Value{ "bar"sv });
+    CHECK(*minjson::JsonPointer{ "/" }.resolve(value) == Value{ 0 });
+    CHECK(*minjson::JsonPointer{ "/a~1b" }.resolve(value) == Value{ 1 });
+    CHECK(*minjson::JsonPointer{ "/c%d" }.resolve(value) == Value{ 2 });
+    CHECK(*minjson::JsonPointer{ "/e^f" }.resolve(value) == Value{ 3 });
+    CHECK(*minjson::JsonPointer{ "/g|h" }.resolve(value) == Value{ 4 });
+    CHECK(*minjson::JsonPointer{ "/i\\j" }.resolve(value) == Value{ 5 });
+    CHECK(*minjson::JsonPointer{ "/k\"l" }.resolve(value) == Value{ 6 });
+    CHECK(*minjson::JsonPointer{ "/ " }.resolve(value) == Value{ 7 });
+    CHECK(*minjson::JsonPointer{ "/m~0n" }.resolve(value) == Value{ 8 });
+  }
+
+  SECTION("arrays and objects") {
+    const minjson::JsonPointer pointer{ "/01/0/1/x" };
+    REQUIRE(pointer.size() == 4);
+    CHECK(pointer[0] == "01"sv);
+    CHECK(pointer[3] == "x"sv);
+    const Value *x = pointer.resolve(std::as_const(value));
+    REQUIRE(x != nullptr);
+    CHECK(x->asBool() == true);
+    CHECK(x == value.resolve(pointer));
+    CHECK(x == std::as_const(value).resolve("01", "0", 1, "x"));
+    pointer.resolve(value)->asBool() = false;
+    CHECK(x->asBool() == false);
+
+    CHECK(*minjson::JsonPointer{ "/key42" }.resolve(value) == Value{ 42 });
+    CHECK(*minjson::JsonPointer{ "/key99" }.resolve(value) == Value{ 99 });
+    CHECK(minjson::JsonPointer{ "/key100" }.resolve(value) == nullptr);
+    CHECK(minjson::JsonPointer{ "/foo/2" }.resolve(value) == nullptr);
+    CHECK(minjson::JsonPointer{ "/foo/-" }.resolve(value) == nullptr);
+    CHECK(minjson::JsonPointer{ "/foo/01" }.resolve(value) == nullptr);
+    CHECK(minjson::JsonPointer{ "/foo/+1" }.resolve(value) == nullptr);
+    CHECK(minjson::JsonPointer{ "/foo/99999999999999999999999" }.resolve(value) == nullptr);
+    CHECK(minjson::JsonPointer{ "/foo/0/0" }.resolve(value) == nullptr);
+    CHECK(minjson::JsonPointer{ "/foo/" }.resolve(value) == nullptr);
+    CHECK(minjson::JsonPointer{ "/1" }.resolve(value) == nullptr);
+  }
+
+  SECTION("string view keys") {
+    const std::string key = "a long key that does not fit into small string buffer";
+    Value o = typename Value::Object{};
+    o.asObject()[typename Value::Object::key_type{ key }] = 42;
+    CHECK(*o.resolve(std::string_view{ key }) == Value{ 42 });
+    CHECK(*o.resolve(key.c_str()) == Value{ 42 });
+    CHECK(o.resolve(std::string_view{ key }.substr(1)) == nullptr);
+  }
+
+  SECTION("set of pointers") {
+    const std::vector<std::string> paths{ "/01/0/1/x", "/foo/1", "/key7", "/foo/2", "/01/0/0", "/m~0n", "/foo/1", "" };
+    const minjson::JsonPointerSet pointers{ paths.begin(), paths.end() };
+    CHECK(pointers.size() == paths.size());
+    const auto resolved = pointers.resolve(value);
+    REQUIRE(resolved.size() == paths.size());
+    for (size_t k = 0; k < paths.size(); ++k) {
+      CAPTURE(paths[k]);
+      CHECK(resolved[k] == minjson::JsonPointer{ paths[k] }.resolve(std::as_const(value)));
+    }
+    CHECK(resolved[3] == nullptr);
+    CHECK(resolved[7] == &value);
+
+    CHECK(minjson::JsonPointerSet{}.resolve(value).empty());
+    CHECK_THROWS_AS((minjson::JsonPointerSet{ "/foo", "bar" }), std::invalid_argument);
+  }
+
+  SECTION("invalid pointers") {
+    CHECK_THROWS_AS(minjson::JsonPointer{ "foo" }, std::invalid_argument);
+    CHECK_THROWS_AS(minjson::JsonPointer{ "/foo~" }, std::invalid_argument);
+    CHECK_THROWS_AS(minjson::JsonPointer{ "/foo~2" }, std::invalid_argument);
+    CHECK_THROWS_AS(minjson::JsonPointer{ "/~/foo" }, std::invalid_argument);
+  }
+}
+
+
+TEMPLATE_TEST_CASE("flat object values", "[value][flat object]",
+                   minjson::FlatObjectValuePolicy, minjson::SortedFlatObjectValuePolicy) {
+  using Value = minjson::BasicValue<std::allocator<char>, TestType>;
+  using Object = typename Value::Object;
+  constexpr bool isSorted = std::is_same_v<TestType, minjson::SortedFlatObjectValuePolicy>;
+
+  SECTION("lookup and insertion") {
+    Object o{ { "b", 1 }, { "a", "foo"sv }, { "c", minjson::Null{} } };
+    REQUIRE(o.size() == 3);
+    CHECK(o.at("a") == Value{ "foo"sv });
+    CHECK(o.contains("b"));
+    CHECK(o.count("d") == 0);
+    CHECK(o.find("d") == o.end());
+    CHECK_THROWS_AS(o.at("d"), std::out_of_range);
+
+    const auto [i, isInserted] = o.try_emplace("a", 42);
+    CHECK_FALSE(isInserted);
+    CHECK(i->second == Value{ "foo"sv });
+    o["d"] = true;
+    CHECK(o.size() == 4);
+    CHECK(o.at("d") == Value{ true });
+
+    std::vector<std::string_view> keys;
+    for (const auto &[key, value] : o)
+      keys.push_back(key);
+    if constexpr (isSorted)
+      CHECK(keys == std::vector{ "a"sv, "b"sv, "c"sv, "d"sv });
+    else
+      CHECK(keys == std::vector{ "b"sv, "a"sv, "c"sv, "d"sv });
+
+    CHECK(o.erase("b") == 1);
+    CHECK(o.erase("b") == 0);
+    CHECK_FALSE(o.contains("b"));
+    CHECK(o.size() == 3);
+
+    CHECK(o == Object{ { "c", minjson::Null{} }, { "d", true }, { "a", "foo"sv } });
+    CHECK(o != Object{ { "c", minjson::Null{} }, { "d", false }, { "a", "foo"sv } });
+    CHECK(o != Object{ { "c", minjson::Null{} }, { "a", "foo"sv } });
+  }
+
+  SECTION("large objects") {
+    Object o;
+    for (int i = 0; i < 1000; ++i)
+      CHECK(o.try_emplace(std::to_string(i), i).second);
+    REQUIRE(o.size() == 1000);
+    for (int i = 0; i < 1000; ++i) {
+      const auto member = o.find(std::to_string(i));
+      REQUIRE(member != o.end());
+      CHECK(member->second == Value{ i });
+    }
+    CHECK_FALSE(o.try_emplace("500", 0).second);
+    CHECK_FALSE(o.contains("1000"));
+
+    for (int i = 0; i < 1000; i += 2)
+      CHECK(o.erase(std::to_string(i)) == 1);
+    REQUIRE(o.size() == 500);
+    for (int i = 0; i < 1000; ++i)
+      CHECK(o.contains(std::to_string(i)) == (i % 2 == 1));
+  }
+
+  SECTION("building large objects with keys in descending order") {
+    constexpr int size = 20'000;
+    std::string input = "{";
+    for (int i = size - 1; i >= 0; --i)
+      input += "\"key" + std::to_string(100'000 + i) + "\": " + std::to_string(i) + (i ? ", " : "}");
+
+    const auto check = [&](const Value &value) {
+      const auto &o = value.asObject();
+      REQUIRE(o.size() == size);
+      if constexpr (isSorted)
+        CHECK(std::is_sorted(o.begin(), o.end(), [](const auto &a, const auto &b) { return a.first < b.first; }));
+      else
+        CHECK(o.begin()->second == Value{ size - 1 });
+      for (int i = 0; i < size; i += 97)
+        CHECK(o.at("key" + std::to_string(100'000 + i)) == Value{ i });
+    };
+
+    const auto [value, status, parsedSize, issues] = minjson::parse<std::allocator<char>, TestType>(input);
+    REQUIRE(status == minjson::ParsingResultStatus::Success);
+    check(value);
+
+    const auto projected = minjson::parseProjected<std::allocator<char>, TestType>(input, minjson::JsonPointerSet{ "" });
+    REQUIRE(projected.status == minjson::ParsingResultStatus::Success);
+    check(projected.value);
+
+    minjson::BasicValueHandler<std::allocator<char>, TestType> handler;
+    minjson::StreamingParser<decltype(handler)> parser{ handler };
+    for (size_t i = 0; i < input.size(); i += 4096)
+      parser.feed(std::string_view{ input }.substr(i, 4096));
+    REQUIRE(parser.finish().status == minjson::ParsingResultStatus::Success);
+    check(handler.value);
+
+    input.back() = ',';
+    input += R"( "key100042": 0 })";
+    const auto duplicate = minjson::parse<std::allocator<char>, TestType>(input);
+    CHECK(duplicate.status == minjson::ParsingResultStatus::Failure);
+    REQUIRE(duplicate.issues.size() == 1);
+    CHECK(duplicate.issues[0].code == minjson::ParsingIssue::Code::DuplicateKeys);
+    CHECK(duplicate.issues[0].offset == input.rfind("\"key100042\""));
+  }
+
+  SECTION("parsing and serialization") {
+    std::string input = R"({ "z": 1, "y": { "b": [ true, null ], "a": "x" })";
+    for (int i = 0; i < 100; ++i)
+      input += ", \"key" + std::to_string(i) + "\": " + std::to_string(i);
+    input += " }";
+
+    const auto [value, status, parsedSize, issues] = minjson::parse<std::allocator<char>, TestType>(input);
+    INFO(PrintIssues{ issues });
+    REQUIRE(status == minjson::ParsingResultStatus::Success);
+    const auto expected = minjson::parse(input).value;
+    CHECK(value.asObject().size() == expected.asObject().size());
+    CHECK(*value.resolve("key42") == Value{ 42 });
+    CHECK(*value.resolve("y", "a") == Value{ "x"sv });
+
+    minjson::SerializationOptions options;
+    options.sortObjectKeys = true;
+    CHECK(minjson::serializeToString(value, options) == minjson::serializeToString(expected, options));
+    if constexpr (!isSorted) {
+      options.sortObjectKeys = false;
+      CHECK(minjson::serializeToString(value, options).compare(0, 12, R"({"z":1,"y":{)") == 0);
+    }
+
+    minjson::ParsingOptions parsingOptions;
+    parsingOptions.duplicateObjectKeys = minjson::ParsingOptions::Option::Ignore;
+    const auto duplicates = minjson::parse<std::allocator<char>, TestType>(R"({ "a": 1, "a": 2 })", parsingOptions);
+    REQUIRE(duplicates.status == minjson::ParsingResultStatus::Success);
+    CHECK(duplicates.value == Value{ Object{ { "a", 2 } } }); // the same as with the default policy
+  }
+}
+
+
+TEST_CASE("compact strings", "[value][compact string]") {
+  using String = minjson::CompactStringValue::String;
+  const std::string inlineText(String::InlineCapacity, 'a');
+  const std::string longerText = inlineText + 'b';
+
+  SECTION("inline and heap storage") {
+    String s;
+    CHECK(s.isInline());
+    CHECK(s.empty());
+    CHECK(s.c_str()[0] == '\0');
+
+    s = inlineText;
+    CHECK(s.isInline());
+    CHECK(s == inlineText);
+    CHECK(s.c_str()[s.size()] == '\0');
+
+    s += "!"sv;
+    CHECK_FALSE(s.isInline());
+    CHECK(s == inlineText + '!');
+    CHECK(s.c_str()[s.size()] == '\0');
+
+    s.clear();
+    CHECK(s.empty());
+    CHECK(s.c_str()[0] == '\0');
+    CHECK_FALSE(s.isInline()); // keeps allocated capacity
+
+    CHECK(String{ inlineText }.isInline());
+    CHECK_FALSE(String{ longerText }.isInline());
+
+    String r;
+    r.reserve(100);
+    CHECK_FALSE(r.isInline());
+    CHECK(r.capacity() >= 100);
+    CHECK(r.empty());
+  }
+
+  SECTION("assigning own contents") {
+    for (const std::string_view text : { "abcdef"sv, std::string_view{ longerText } }) {
+      String s{ text };
+      s = std::string_view{ s }.substr(0, 3);
+      CHECK(s == text.substr(0, 3));
+      s = text;
+      s = std::string_view{ s }.substr(2);
+      CHECK(s == text.substr(2));
+      s = std::string_view{ s };
+      CHECK(s == text.substr(2));
+    }
+  }
+
+  SECTION("appending across inline capacity") {
+    String s;
+    std::string expected;
+    for (char c = 'a'; c <= 'z'; ++c) {
+      s.push_back(c);
+      s.append("0123"sv);
+      expected += c;
+      expected += "0123";
+      REQUIRE(std::string_view{ s } == expected);
+    }
+    CHECK(s.size() == 26 * 5);
+
+    String self{ "self" };
+    for (int i = 0; i < 4; ++i)
+      self.append(std::string_view{ self });
+    CHECK(self.size() == 4 * 16);
+    CHECK(std::string_view{ self }.substr(0, 12) == "selfselfself");
+  }
+
+  SECTION("copying and moving") {
+    for (const std::string_view text : { inlineText, longerText }) {
+      String s{ text };
+      String copy{ s };
+      CHECK(copy == s);
+      CHECK(copy.data() != s.data());
+
+      const char *data = s.data();
+      String moved{ std::move(s) };
+      CHECK(moved == text);
+      CHECK(s.empty());
+      CHECK((moved.data() == data) == !moved.isInline());
+
+      copy = moved;
+      CHECK(copy == text);
+      s = std::move(copy);
+      CHECK(s == text);
+      String &alias = s;
+      s = std::move(alias);
+      CHECK(s == text);
+    }
+  }
+
+  SECTION("comparison and hashing") {
+    CHECK(String{ "abc" } == String{ "abc" });
+    CHECK(String{ "abc" } != String{ "abd" });
+    CHECK(String{ "abc" } < String{ "abd" });
+    CHECK(String{ longerText } == longerText);
+    CHECK("abc"sv == String{ "abc" });
+    CHECK(std::hash<String>{}(String{ longerText }) == std::hash<std::string_view>{}(longerText));
+  }
+
+  SECTION("values") {
+    const std::string input = R"({ "short": "text", "long": ")" + longerText + R"(" })";
+    const auto [value, status, parsedSize, issues] =
+      minjson::parse<std::allocator<char>, minjson::CompactStringValuePolicy>(input);
+    INFO(PrintIssues{ issues });
+    REQUIRE(status == minjson::ParsingResultStatus::Success);
+    CHECK(value.resolve("short")->asString().isInline());
+    CHECK_FALSE(value.resolve("long")->asString().isInline());
+    CHECK(minjson::serializeToString(value) == minjson::serializeToString(minjson::parse(input).value));
+  }
+}